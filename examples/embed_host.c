@@ -0,0 +1,71 @@
+/*
+ * Minimal host embedding the advection simulators through the C API.
+ *
+ * A pulse wave is advected once around the periodic domain [-1, 1] with the
+ * TVD minmod scheme. The state array is owned by this program and advanced in
+ * place by the library.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "cfd_advect.h"
+
+int main(void) {
+  const int n_domain_cells = 100;
+  const double x_left = -1.0;
+  const double x_right = 1.0;
+  const double dx = (x_right - x_left) / n_domain_cells;
+
+  cfd_advect_params params;
+  params.n_domain_cells = n_domain_cells;
+  params.n_boundary_cells = 2;
+  params.dx = dx;
+  params.dt = 0.2 * dx;
+  params.velocity = 1.0;
+  params.eps = 0.25;
+
+  cfd_advect_simulator* simulator = NULL;
+  cfd_advect_status status =
+      cfd_advect_create(&params, CFD_ADVECT_TVD_MINMOD, &simulator);
+  if (status != CFD_ADVECT_OK) {
+    fprintf(stderr, "Failed to create a simulator: %s\n",
+            cfd_advect_status_string(status));
+    return EXIT_FAILURE;
+  }
+
+  const int n_total_cells = cfd_advect_n_total_cells(simulator);
+  const int offset = cfd_advect_domain_offset(simulator);
+  double* u = (double*)calloc((size_t)n_total_cells, sizeof(double));
+  if (u == NULL) {
+    cfd_advect_destroy(simulator);
+    return EXIT_FAILURE;
+  }
+  for (int i = n_domain_cells / 2 - 10; i <= n_domain_cells / 2 + 10; ++i) {
+    u[offset + i] = 1.0;
+  }
+
+  /* Advance to t = 2.0, where the pulse is back at its initial position. */
+  status = cfd_advect_advance_to(simulator, u, 2.0);
+  if (status != CFD_ADVECT_OK) {
+    fprintf(stderr, "Failed to advance: %s\n",
+            cfd_advect_status_string(status));
+    free(u);
+    cfd_advect_destroy(simulator);
+    return EXIT_FAILURE;
+  }
+
+  double mass = 0.0;
+  double u_max = 0.0;
+  for (int i = 0; i < n_domain_cells; ++i) {
+    mass += u[offset + i] * dx;
+    if (u[offset + i] > u_max) {
+      u_max = u[offset + i];
+    }
+  }
+  printf("cfd_advect %s: t = %g, mass = %.12f, max = %.6f\n",
+         cfd_advect_version(), cfd_advect_time(simulator), mass, u_max);
+
+  free(u);
+  cfd_advect_destroy(simulator);
+  return EXIT_SUCCESS;
+}
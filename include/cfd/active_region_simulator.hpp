@@ -0,0 +1,195 @@
+#ifndef CFD_ACTIVE_REGION_SIMULATOR_HPP
+#define CFD_ACTIVE_REGION_SIMULATOR_HPP
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include "cfd/boundary_conditions.hpp"
+#include "cfd/periodic_boundary.hpp"
+#include "cfd/problem_parameters.hpp"
+
+namespace cfd {
+
+/**
+ * @brief Options of active region tracking
+ */
+struct ActiveRegionOptions {
+  int block_size = 64;     ///> Number of cells of a block
+  double threshold = 0.0;  ///> Blocks whose cells change by at most this
+                           ///> value in a time step are quiescent
+};
+
+/**
+ * @brief Report of a run with active region tracking
+ */
+struct ActiveRegionReport {
+  long long cell_updates = 0;       ///> Number of cell updates performed
+  long long full_cell_updates = 0;  ///> Number of cell updates of full sweeps
+
+  /// Fraction of cell updates performed compared to full sweeps
+  double active_fraction() const noexcept {
+    return full_cell_updates > 0 ? static_cast<double>(cell_updates) /
+                                       static_cast<double>(full_cell_updates)
+                                 : 0.0;
+  }
+};
+
+/**
+ * @brief Scalar advection equation simulator which skips quiescent blocks
+ *
+ * The domain is split into blocks of cells. Only active blocks are
+ * reconstructed, fluxed and updated in a time step, where a block is active if
+ * a cell within n_boundary_cells, i.e. the stencil width, of the block changed
+ * by more than the threshold in the previous time step. All blocks are active
+ * in the first time step, and the neighbourhood wraps around the domain ends.
+ *
+ * If no cell in the stencil of a cell changed, its fluxes are the same as in
+ * the previous time step, in which the cell did not change either. Therefore
+ * the results are identical to full sweeps if the threshold is 0.
+ *
+ * The time integrator must be single-stage, i.e. provide update(u, f).
+ */
+template <typename RiemannSolver, typename SpacialReconstructor,
+          typename TimeIntegrator, typename Boundary = PeriodicBoundary>
+class ActiveRegionSimulator {
+ public:
+  /**
+   * @brief Construct a new Active Region Simulator object
+   *
+   * @param params Problem parameters
+   * @param options Active region options
+   */
+  ActiveRegionSimulator(const ProblemParameters& params,
+                        const ActiveRegionOptions& options = {})
+      : params_{params}, options_{options}, boundary_{params} {
+    assert(options.block_size >= 1 && options.threshold >= 0);
+  }
+
+  /**
+   * @brief Construct a new Active Region Simulator object
+   *
+   * @param params Problem parameters
+   * @param boundary Boundary conditions
+   * @param options Active region options
+   */
+  ActiveRegionSimulator(const ProblemParameters& params,
+                        const Boundary& boundary,
+                        const ActiveRegionOptions& options = {})
+      : params_{params}, options_{options}, boundary_{boundary} {
+    assert(options.block_size >= 1 && options.threshold >= 0);
+  }
+
+  /**
+   * @brief Run simulator
+   *
+   * @tparam Derived
+   * @param u0 Initial condition
+   * @param report Report of the run, if not null
+   * @return Eigen::VectorXd Values at the end of time steps.
+   */
+  template <typename Derived>
+  Eigen::VectorXd run(const Eigen::MatrixBase<Derived>& u0,
+                      ActiveRegionReport* report = nullptr) const {
+    using Eigen::seqN;
+    using Eigen::VectorXd;
+
+    const auto nb = params_.n_boundary_cells;
+    const auto nd = params_.n_domain_cells;
+    // Blocks must be at least as large as the stencil. The last block also
+    // takes the remaining cells, so it is never smaller than the others.
+    const int block_size = std::min(std::max(options_.block_size, nb), nd);
+    const int n_blocks = nd / block_size;
+    const int last_size = nd - (n_blocks - 1) * block_size;
+    const int n_halo_blocks = (nb + block_size - 1) / block_size;
+
+    auto block_params = params_;
+    block_params.n_domain_cells = block_size;
+    auto last_params = params_;
+    last_params.n_domain_cells = last_size;
+    const Block block{block_params};
+    const Block last{last_params};
+
+    VectorXd u(params_.n_total_cells());
+    u(seqN(nb, nd)) = u0;
+    boundary_.apply(u);
+
+    std::vector<char> active(n_blocks, 1);
+    std::vector<char> changed(n_blocks, 0);
+    std::vector<int> active_blocks;
+    std::vector<VectorXd> fluxes(n_blocks);
+    VectorXd previous(last_size);
+    long long cell_updates = 0;
+
+    for (int i = 1; i <= params_.n_timesteps; ++i) {
+      active_blocks.clear();
+      for (int b = 0; b < n_blocks; ++b) {
+        if (active[b]) {
+          active_blocks.push_back(b);
+        }
+      }
+
+      // Fluxes of all active blocks are computed before any update, since
+      // blocks share cells in their stencils.
+      for (const auto b : active_blocks) {
+        const auto& s = b == n_blocks - 1 ? last : block;
+        const int len = b == n_blocks - 1 ? last_size : block_size;
+        const auto view = u.segment(b * block_size, len + 2 * nb);
+        const VectorXd ul = s.reconstructor.calc_left(view);
+        const VectorXd ur = s.reconstructor.calc_right(view);
+        fluxes[b] = s.solver.calc_flux(ul, ur);
+      }
+
+      std::fill(changed.begin(), changed.end(), 0);
+      for (const auto b : active_blocks) {
+        const auto& s = b == n_blocks - 1 ? last : block;
+        const int len = b == n_blocks - 1 ? last_size : block_size;
+        auto view = u.segment(b * block_size, len + 2 * nb);
+        previous.head(len) = view.segment(nb, len);
+        s.integrator.update(view, fluxes[b]);
+        const double change =
+            (view.segment(nb, len) - previous.head(len)).cwiseAbs().maxCoeff();
+        changed[b] = change > options_.threshold;
+        cell_updates += len;
+      }
+      boundary_.apply(u);
+
+      std::fill(active.begin(), active.end(), 0);
+      for (int b = 0; b < n_blocks; ++b) {
+        if (!changed[b]) {
+          continue;
+        }
+        for (int d = -n_halo_blocks; d <= n_halo_blocks; ++d) {
+          active[((b + d) % n_blocks + n_blocks) % n_blocks] = 1;
+        }
+      }
+    }
+
+    if (report) {
+      report->cell_updates = cell_updates;
+      report->full_cell_updates =
+          static_cast<long long>(nd) * params_.n_timesteps;
+    }
+    return u(seqN(nb, nd));
+  }
+
+ private:
+  /// Schemes applied to a view of a block with its neighbouring cells
+  struct Block {
+    explicit Block(const ProblemParameters& params)
+        : solver{params}, reconstructor{params}, integrator{params} {}
+
+    RiemannSolver solver;
+    SpacialReconstructor reconstructor;
+    TimeIntegrator integrator;
+  };
+
+  ProblemParameters params_;
+  ActiveRegionOptions options_;
+  Boundary boundary_;
+};
+
+}  // namespace cfd
+
+#endif  // CFD_ACTIVE_REGION_SIMULATOR_HPP
@@ -0,0 +1,339 @@
+#ifndef CFD_AUTO_TUNER_HPP
+#define CFD_AUTO_TUNER_HPP
+
+#include <fmt/core.h>
+#include <omp.h>
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <typeinfo>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include "cfd/active_region_simulator.hpp"
+#include "cfd/parallel_scalar_advection_equation_simulator.hpp"
+#include "cfd/problem_parameters.hpp"
+#include "cfd/result_cache.hpp"
+#include "cfd/scalar_advection_equation_simulator.hpp"
+#include "cfd/version.hpp"
+
+namespace cfd {
+
+/**
+ * @brief Options of auto-tuning
+ */
+struct AutoTunerOptions {
+  int benchmark_steps = 20;  ///> Number of time steps of a benchmark run
+  int repetitions = 3;       ///> Number of benchmark runs per candidate
+  double tolerance = 1e-12;  ///> Maximum deviation from the reference
+};
+
+/**
+ * @brief Kernel variants selectable by auto-tuning
+ */
+enum class KernelVariant {
+  serial,         ///> ScalarAdvectionEquationSimulator
+  parallel,       ///> ParallelScalarAdvectionEquationSimulator
+  active_region,  ///> ActiveRegionSimulator
+};
+
+/**
+ * @brief Configuration of a kernel variant
+ */
+struct TuningDecision {
+  KernelVariant variant = KernelVariant::serial;  ///> Kernel variant
+  int n_threads = 1;                              ///> Number of threads
+  int block_size = 0;                             ///> Cells of a block
+  double seconds_per_step = 0.0;  ///> Benchmarked wall time per time step
+
+  /// Human-readable description
+  std::string describe() const {
+    switch (variant) {
+      case KernelVariant::parallel:
+        return fmt::format("parallel ({} threads)", n_threads);
+      case KernelVariant::active_region:
+        return fmt::format("active region ({} cells per block)", block_size);
+      default:
+        return "serial";
+    }
+  }
+};
+
+/**
+ * @brief Report of auto-tuning
+ */
+struct AutoTunerReport {
+  bool cached = false;          ///> Whether the decision was read from file
+  int n_candidates = 0;         ///> Number of candidates benchmarked
+  int n_rejected = 0;           ///> Number of candidates deviating from the
+                                ///> reference
+  double tuning_seconds = 0.0;  ///> Wall time of benchmarks
+  TuningDecision decision;      ///> Selected configuration
+};
+
+/**
+ * @brief Returns the name of this host
+ *
+ * @return std::string Host name, or "localhost" if unknown
+ */
+inline std::string host_name() {
+#if defined(__unix__) || defined(__APPLE__)
+  char name[256] = {};
+  if (gethostname(name, sizeof(name) - 1) == 0 && name[0] != '\0') {
+    return name;
+  }
+#elif defined(_WIN32)
+  char name[MAX_COMPUTERNAME_LENGTH + 1] = {};
+  DWORD size = sizeof(name);
+  if (GetComputerNameA(name, &size) && size > 0) {
+    return std::string(name, size);
+  }
+#endif
+  return "localhost";
+}
+
+/**
+ * @brief Auto-tuner selecting the fastest kernel variant of a scheme
+ *
+ * Candidates are the serial simulator, the parallel simulator with thread
+ * counts of powers of two up to the OpenMP default, and the active region
+ * simulator with several block sizes. For a given number of domain cells,
+ * each candidate is run for a few time steps and timed, and candidates whose
+ * results deviate from those of ScalarAdvectionEquationSimulator, which serves
+ * as the reference, are rejected. The fastest candidate is recorded in a
+ * tuning file of this host, from which later runs read it without
+ * benchmarking. Since the active region simulator benefits from quiescent
+ * cells, benchmarks should be run with a representative initial condition.
+ *
+ * Decisions are keyed by the library version, the template arguments of the
+ * tuner, a scheme name given by the caller, the numbers of domain and boundary
+ * cells, the OpenMP default number of threads, and the initial condition,
+ * since the benefit of active regions depends on how much of the domain is
+ * active. A tuning file that cannot be written is reported to stderr, and the
+ * decision is used without being recorded. The time integrator must be
+ * single-stage, i.e. provide update(u, f).
+ */
+template <typename RiemannSolver, typename SpacialReconstructor,
+          typename TimeIntegrator>
+class AutoTuner {
+ public:
+  /**
+   * @brief Construct a new Auto Tuner object
+   *
+   * @param directory Directory to store tuning files
+   * @param options Auto-tuning options
+   */
+  AutoTuner(const std::filesystem::path& directory,
+            const AutoTunerOptions& options = {})
+      : directory_{directory}, options_{options} {}
+
+  /**
+   * @brief Select the fastest kernel variant
+   *
+   * @tparam Derived
+   * @param scheme Name of the run, e.g. "tvd_minmod". Tuners of different
+   * template arguments never share a key, even under the same name.
+   * @param params Problem parameters
+   * @param u0 Initial condition used for benchmarks
+   * @param report Report of auto-tuning, if not null
+   * @return TuningDecision Selected configuration
+   */
+  template <typename Derived>
+  TuningDecision tune(const std::string& scheme,
+                      const ProblemParameters& params,
+                      const Eigen::MatrixBase<Derived>& u0,
+                      AutoTunerReport* report = nullptr) const {
+    AutoTunerReport r;
+    const Eigen::VectorXd initial = u0;
+    const auto key = make_key(scheme, params, initial);
+    if (this->load(key, r.decision)) {
+      r.cached = true;
+    } else {
+      const double start = omp_get_wtime();
+      r.decision = this->benchmark(params, initial, r);
+      r.tuning_seconds = omp_get_wtime() - start;
+      this->save(key, r.decision);
+    }
+    if (report) {
+      *report = r;
+    }
+    return r.decision;
+  }
+
+  /**
+   * @brief Run the fastest kernel variant
+   *
+   * @tparam Derived
+   * @param scheme Name of the scheme
+   * @param params Problem parameters
+   * @param u0 Initial condition
+   * @param report Report of auto-tuning, if not null
+   * @return Eigen::VectorXd Values at the end of time steps.
+   */
+  template <typename Derived>
+  Eigen::VectorXd run(const std::string& scheme,
+                      const ProblemParameters& params,
+                      const Eigen::MatrixBase<Derived>& u0,
+                      AutoTunerReport* report = nullptr) const {
+    return execute(this->tune(scheme, params, u0, report), params, u0);
+  }
+
+ private:
+  using Reference = ScalarAdvectionEquationSimulator<
+      RiemannSolver, SpacialReconstructor, TimeIntegrator>;
+  using Parallel = ParallelScalarAdvectionEquationSimulator<
+      RiemannSolver, SpacialReconstructor, TimeIntegrator>;
+  using ActiveRegion =
+      ActiveRegionSimulator<RiemannSolver, SpacialReconstructor,
+                            TimeIntegrator>;
+
+  template <typename Derived>
+  static Eigen::VectorXd execute(const TuningDecision& decision,
+                                 const ProblemParameters& params,
+                                 const Eigen::MatrixBase<Derived>& u0) {
+    switch (decision.variant) {
+      case KernelVariant::parallel: {
+        ThreadingOptions options;
+        options.n_threads = decision.n_threads;
+        return Parallel{params, options}.run(u0);
+      }
+      case KernelVariant::active_region: {
+        ActiveRegionOptions options;
+        options.block_size = decision.block_size;
+        return ActiveRegion{params, options}.run(u0);
+      }
+      default:
+        return Reference{params}.run(u0);
+    }
+  }
+
+  /// Candidate configurations, the reference first
+  static std::vector<TuningDecision> candidates(
+      const ProblemParameters& params) {
+    std::vector<TuningDecision> candidates{{KernelVariant::serial, 1, 0}};
+    const int max_threads =
+        std::min(omp_get_max_threads(), params.n_domain_cells);
+    for (int n = 2; n < 2 * max_threads; n *= 2) {
+      candidates.push_back(
+          {KernelVariant::parallel, std::min(n, max_threads), 0});
+    }
+    for (const int block_size : {64, 256, 1024}) {
+      if (block_size < params.n_domain_cells) {
+        candidates.push_back({KernelVariant::active_region, 1, block_size});
+      }
+    }
+    return candidates;
+  }
+
+  /// Benchmark all candidates, and return the fastest valid one
+  template <typename Derived>
+  TuningDecision benchmark(const ProblemParameters& params,
+                           const Eigen::MatrixBase<Derived>& u0,
+                           AutoTunerReport& report) const {
+    auto bench_params = params;
+    bench_params.n_timesteps = std::max(options_.benchmark_steps, 1);
+    const Eigen::VectorXd initial = u0;
+    const Eigen::VectorXd reference = Reference{bench_params}.run(initial);
+
+    TuningDecision best;
+    best.seconds_per_step = std::numeric_limits<double>::infinity();
+    for (auto candidate : candidates(params)) {
+      double seconds = std::numeric_limits<double>::infinity();
+      Eigen::VectorXd result;
+      for (int i = 0; i < std::max(options_.repetitions, 1); ++i) {
+        const double start = omp_get_wtime();
+        result = execute(candidate, bench_params, initial);
+        seconds = std::min(seconds, omp_get_wtime() - start);
+      }
+      report.n_candidates += 1;
+      if ((result - reference).cwiseAbs().maxCoeff() > options_.tolerance) {
+        report.n_rejected += 1;
+        continue;
+      }
+      candidate.seconds_per_step = seconds / bench_params.n_timesteps;
+      if (candidate.seconds_per_step < best.seconds_per_step) {
+        best = candidate;
+      }
+    }
+    return best;
+  }
+
+  static std::string make_key(const std::string& scheme,
+                              const ProblemParameters& params,
+                              const Eigen::VectorXd& u0) {
+    Fnv1aHash hash;
+    hash.update(library_version());
+    hash.update(typeid(Reference).name());
+    hash.update(scheme.c_str());
+    hash.update_value(params.n_domain_cells);
+    hash.update_value(params.n_boundary_cells);
+    hash.update_value(omp_get_max_threads());
+    hash.update_value(u0.size());
+    hash.update(u0.data(), sizeof(double) * u0.size());
+    return fmt::format("{:016x}", hash.value());
+  }
+
+  std::filesystem::path file_path() const {
+    return directory_ / fmt::format("tuning_{}.txt", host_name());
+  }
+
+  /// Read the latest decision of a key from the tuning file
+  bool load(const std::string& key, TuningDecision& decision) const {
+    std::ifstream file(this->file_path());
+    std::string k, variant;
+    TuningDecision d;
+    bool found = false;
+    while (file >> k >> variant >> d.n_threads >> d.block_size >>
+           d.seconds_per_step) {
+      if (k != key) {
+        continue;
+      }
+      if (variant == "serial") {
+        d.variant = KernelVariant::serial;
+      } else if (variant == "parallel") {
+        d.variant = KernelVariant::parallel;
+      } else if (variant == "active_region") {
+        d.variant = KernelVariant::active_region;
+      } else {
+        continue;
+      }
+      decision = d;
+      found = true;
+    }
+    return found;
+  }
+
+  /// Append a decision to the tuning file, if possible
+  void save(const std::string& key, const TuningDecision& decision) const {
+    static constexpr const char* names[] = {"serial", "parallel",
+                                            "active_region"};
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+    std::ofstream file(this->file_path(), std::ios::app);
+    file << fmt::format("{} {} {} {} {:.6e}\n", key,
+                        names[static_cast<int>(decision.variant)],
+                        decision.n_threads, decision.block_size,
+                        decision.seconds_per_step);
+    if (!file) {
+      fmt::print(stderr, "Failed to write a tuning file: {}\n",
+                 this->file_path().string());
+    }
+  }
+
+  std::filesystem::path directory_;  ///> Directory to store tuning files
+  AutoTunerOptions options_;
+};
+
+}  // namespace cfd
+
+#endif  // CFD_AUTO_TUNER_HPP
@@ -0,0 +1,311 @@
+#ifndef CFD_BINARY_FILE_IO_HPP
+#define CFD_BINARY_FILE_IO_HPP
+
+#include <fmt/core.h>
+
+#include <Eigen/Core>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include "cfd/problem_parameters.hpp"
+
+namespace cfd {
+
+/**
+ * @brief Layout of binary files
+ *
+ * A binary file is either a raw array of doubles, or a 16-byte header followed
+ * by the array. The header consists of the magic bytes "CFDVEC01" and the
+ * number of values as a 64-bit unsigned integer. Values are stored in the
+ * native byte order.
+ */
+struct BinaryFileFormat {
+  static constexpr char magic[8] = {'C', 'F', 'D', 'V', 'E', 'C', '0', '1'};
+  static constexpr std::size_t header_size = 16;
+};
+
+/**
+ * @brief Read-only vector of doubles memory-mapped from a binary file
+ *
+ * Pages are read from the file lazily on first access, so only the parts of a
+ * file which are actually accessed are loaded.
+ */
+class MappedVector {
+ public:
+  using ConstMap = Eigen::Map<const Eigen::VectorXd>;
+
+  MappedVector() noexcept = default;
+
+  MappedVector(const MappedVector&) = delete;
+  MappedVector& operator=(const MappedVector&) = delete;
+
+  MappedVector(MappedVector&& other) noexcept
+      : mapping_{std::exchange(other.mapping_, nullptr)},
+        mapped_bytes_{std::exchange(other.mapped_bytes_, 0)},
+        offset_{std::exchange(other.offset_, 0)},
+        size_{std::exchange(other.size_, 0)} {}
+
+  MappedVector& operator=(MappedVector&& other) noexcept {
+    if (this != &other) {
+      this->release();
+      mapping_ = std::exchange(other.mapping_, nullptr);
+      mapped_bytes_ = std::exchange(other.mapped_bytes_, 0);
+      offset_ = std::exchange(other.offset_, 0);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  ~MappedVector() { this->release(); }
+
+  /**
+   * @brief Map a binary file
+   *
+   * @param path Path to a binary file
+   * @return MappedVector Mapped vector. Empty if the file cannot be mapped.
+   */
+  static MappedVector map(const std::filesystem::path& path) noexcept {
+    MappedVector v;
+#if defined(__unix__) || defined(__APPLE__)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return v;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+      const auto bytes = static_cast<std::size_t>(st.st_size);
+      void* p = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p != MAP_FAILED) {
+#if defined(MADV_SEQUENTIAL)
+        ::madvise(p, bytes, MADV_SEQUENTIAL);
+#endif
+        v.mapping_ = p;
+        v.mapped_bytes_ = bytes;
+      }
+    }
+    // The mapping stays valid after the file is closed.
+    ::close(fd);
+#elif defined(_WIN32)
+    const HANDLE file =
+        CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                    OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      return v;
+    }
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+      const HANDLE mapping =
+          CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping != nullptr) {
+        void* p = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (p != nullptr) {
+          v.mapping_ = p;
+          v.mapped_bytes_ = static_cast<std::size_t>(size.QuadPart);
+        }
+        CloseHandle(mapping);
+      }
+    }
+    CloseHandle(file);
+#else
+    static_cast<void>(path);
+#endif
+    v.parse();
+    return v;
+  }
+
+  /// Whether a file is mapped and its layout is valid
+  bool valid() const noexcept { return mapping_ != nullptr && size_ >= 0; }
+
+  /// Number of values
+  Eigen::Index size() const noexcept { return size_; }
+
+  /// Values without copying them
+  ConstMap values() const noexcept {
+    return ConstMap(reinterpret_cast<const double*>(
+                        static_cast<const char*>(mapping_) + offset_),
+                    size_);
+  }
+
+ private:
+  /// Detect the layout of the mapped file and set offset_ and size_
+  void parse() noexcept {
+    using Format = BinaryFileFormat;
+    size_ = -1;
+    if (mapping_ == nullptr) {
+      return;
+    }
+    const auto* bytes = static_cast<const char*>(mapping_);
+    if (mapped_bytes_ >= Format::header_size &&
+        std::memcmp(bytes, Format::magic, sizeof(Format::magic)) == 0) {
+      std::uint64_t n = 0;
+      std::memcpy(&n, bytes + sizeof(Format::magic), sizeof(n));
+      if (n <= (mapped_bytes_ - Format::header_size) / sizeof(double) &&
+          Format::header_size + n * sizeof(double) == mapped_bytes_) {
+        offset_ = Format::header_size;
+        size_ = static_cast<Eigen::Index>(n);
+      }
+    } else if (mapped_bytes_ % sizeof(double) == 0) {
+      offset_ = 0;
+      size_ = static_cast<Eigen::Index>(mapped_bytes_ / sizeof(double));
+    }
+  }
+
+  void release() noexcept {
+    if (mapping_ == nullptr) {
+      return;
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    ::munmap(mapping_, mapped_bytes_);
+#elif defined(_WIN32)
+    UnmapViewOfFile(mapping_);
+#endif
+    mapping_ = nullptr;
+    mapped_bytes_ = 0;
+    offset_ = 0;
+    size_ = 0;
+  }
+
+  void* mapping_ = nullptr;       ///> Start of the mapping
+  std::size_t mapped_bytes_ = 0;  ///> Size of the mapping in bytes
+  std::size_t offset_ = 0;        ///> Offset of the first value in bytes
+  Eigen::Index size_ = 0;         ///> Number of values
+};
+
+class BinaryFileReader {
+ public:
+  /**
+   * @brief Construct a new Binary File Reader object
+   *
+   * @param directory Directory to read files from
+   */
+  BinaryFileReader(const std::filesystem::path& directory)
+      : directory_{directory} {}
+
+  /**
+   * @brief Map a file.
+   *
+   * @param filename File name
+   * @return MappedVector Mapped values
+   */
+  MappedVector read(const std::string& filename) const noexcept {
+    namespace fs = std::filesystem;
+    const auto path = directory_ / fs::path(filename);
+    auto v = MappedVector::map(path);
+    if (!v.valid()) {
+      fmt::print(stderr, "Failed to map a binary file: {}\n", path.string());
+      std::exit(EXIT_FAILURE);
+    }
+    return v;
+  }
+
+  /**
+   * @brief Map a file of values in domain cells, e.g. an initial condition or
+   * cell centers.
+   *
+   * @param filename File name
+   * @param params Problem parameters
+   * @return MappedVector Mapped values of n_domain_cells
+   */
+  MappedVector read(const std::string& filename,
+                    const ProblemParameters& params) const noexcept {
+    auto v = this->read(filename);
+    if (v.size() != params.n_domain_cells) {
+      fmt::print(stderr, "Size mismatch in a binary file: {}\n",
+                 (directory_ / filename).string());
+      fmt::print(stderr, "Expected {} values, but found {}\n",
+                 params.n_domain_cells, v.size());
+      std::exit(EXIT_FAILURE);
+    }
+    return v;
+  }
+
+ private:
+  std::filesystem::path directory_;  ///> Directory to read files from
+};
+
+class BinaryFileWriter {
+ public:
+  /**
+   * @brief Construct a new Binary File Writer object
+   *
+   * @param directory Directory to output files
+   */
+  BinaryFileWriter(const std::filesystem::path& directory)
+      : directory_{directory} {}
+
+  /**
+   * @brief Write data to a file with a header.
+   *
+   * @param x Data
+   * @param filename File name
+   */
+  template <typename Derived>
+  void write(const Eigen::MatrixBase<Derived>& x,
+             const std::string& filename) const noexcept {
+    std::error_code ec;
+    if (!this->try_write(x, filename, ec)) {
+      fmt::print(stderr, "Failed to write a binary file: {}\n",
+                 (directory_ / filename).string());
+      fmt::print(stderr, "Error code: {}\n", ec.message());
+      std::exit(EXIT_FAILURE);
+    }
+  }
+
+  /**
+   * @brief Write data to a file with a header, leaving failures to the caller.
+   *
+   * @param x Data
+   * @param filename File name
+   * @param ec Error code set on failure
+   * @return true if the file is written
+   */
+  template <typename Derived>
+  bool try_write(const Eigen::MatrixBase<Derived>& x,
+                 const std::string& filename,
+                 std::error_code& ec) const noexcept {
+    namespace fs = std::filesystem;
+    using Format = BinaryFileFormat;
+    ec.clear();
+    if (!fs::exists(directory_, ec)) {
+      fs::create_directories(directory_, ec);
+    }
+    if (ec) {
+      return false;
+    }
+    const Eigen::VectorXd values = x;
+    const auto n = static_cast<std::uint64_t>(values.size());
+    std::ofstream file(directory_ / fs::path(filename), std::ios::binary);
+    file.write(Format::magic, sizeof(Format::magic));
+    file.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    file.write(reinterpret_cast<const char*>(values.data()),
+               static_cast<std::streamsize>(n * sizeof(double)));
+    file.close();
+    if (!file) {
+      ec = std::make_error_code(std::errc::io_error);
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  std::filesystem::path directory_;  ///> Directory to output files
+};
+
+}  // namespace cfd
+
+#endif  // CFD_BINARY_FILE_IO_HPP
@@ -0,0 +1,145 @@
+#ifndef CFD_BOUNDARY_CONDITIONS_HPP
+#define CFD_BOUNDARY_CONDITIONS_HPP
+
+#include <Eigen/Core>
+#include <cassert>
+
+#include "cfd/problem_parameters.hpp"
+
+namespace cfd {
+
+/**
+ * @brief Dirichlet boundaries with fixed values in boundary cells
+ *
+ * This is an inflow boundary on the upwind side of the domain.
+ */
+class DirichletBoundary {
+ public:
+  DirichletBoundary(int n_boundary_cells, int n_domain_cells,
+                    double left_value = 0.0, double right_value = 0.0)
+      : n_boundary_cells_{n_boundary_cells},
+        n_domain_cells_{n_domain_cells},
+        left_value_{left_value},
+        right_value_{right_value} {}
+
+  DirichletBoundary(const ProblemParameters& params, double left_value = 0.0,
+                    double right_value = 0.0)
+      : n_boundary_cells_{params.n_boundary_cells},
+        n_domain_cells_{params.n_domain_cells},
+        left_value_{left_value},
+        right_value_{right_value} {}
+
+  template <typename Derived>
+  void apply(Eigen::MatrixBase<Derived>& u) const noexcept {
+    assert(u.size() == (n_boundary_cells_ * 2 + n_domain_cells_));
+    u.head(n_boundary_cells_).setConstant(left_value_);
+    u.tail(n_boundary_cells_).setConstant(right_value_);
+  }
+
+ private:
+  int n_boundary_cells_;
+  int n_domain_cells_;
+  double left_value_;
+  double right_value_;
+};
+
+/**
+ * @brief Outflow boundaries with zero gradient
+ *
+ * Boundary cells take the value of the nearest domain cell.
+ */
+class OutflowBoundary {
+ public:
+  OutflowBoundary(int n_boundary_cells, int n_domain_cells)
+      : n_boundary_cells_{n_boundary_cells}, n_domain_cells_{n_domain_cells} {}
+
+  OutflowBoundary(const ProblemParameters& params)
+      : n_boundary_cells_{params.n_boundary_cells},
+        n_domain_cells_{params.n_domain_cells} {}
+
+  template <typename Derived>
+  void apply(Eigen::MatrixBase<Derived>& u) const noexcept {
+    assert(u.size() == (n_boundary_cells_ * 2 + n_domain_cells_));
+    const auto nb = n_boundary_cells_;
+    const auto nd = n_domain_cells_;
+    u.head(nb).setConstant(u(nb));
+    u.tail(nb).setConstant(u(nb + nd - 1));
+  }
+
+ private:
+  int n_boundary_cells_;
+  int n_domain_cells_;
+};
+
+/**
+ * @brief Reflective boundaries
+ *
+ * Boundary cells mirror domain cells across the domain ends.
+ */
+class ReflectiveBoundary {
+ public:
+  ReflectiveBoundary(int n_boundary_cells, int n_domain_cells)
+      : n_boundary_cells_{n_boundary_cells}, n_domain_cells_{n_domain_cells} {
+    assert(n_boundary_cells <= n_domain_cells);
+  }
+
+  ReflectiveBoundary(const ProblemParameters& params)
+      : n_boundary_cells_{params.n_boundary_cells},
+        n_domain_cells_{params.n_domain_cells} {
+    assert(n_boundary_cells_ <= n_domain_cells_);
+  }
+
+  template <typename Derived>
+  void apply(Eigen::MatrixBase<Derived>& u) const noexcept {
+    assert(u.size() == (n_boundary_cells_ * 2 + n_domain_cells_));
+    const auto nb = n_boundary_cells_;
+    const auto nd = n_domain_cells_;
+    u.head(nb) = u.segment(nb, nb).reverse();
+    u.tail(nb) = u.segment(nd, nb).reverse();
+  }
+
+ private:
+  int n_boundary_cells_;
+  int n_domain_cells_;
+};
+
+/**
+ * @brief Inflow boundary on the upwind side and outflow boundary on the
+ * downwind side of the domain
+ *
+ * The upwind side is given by the sign of the velocity in the problem
+ * parameters.
+ */
+class InflowOutflowBoundary {
+ public:
+  InflowOutflowBoundary(const ProblemParameters& params,
+                        double inflow_value = 0.0)
+      : n_boundary_cells_{params.n_boundary_cells},
+        n_domain_cells_{params.n_domain_cells},
+        inflow_from_left_{params.velocity >= 0},
+        inflow_value_{inflow_value} {}
+
+  template <typename Derived>
+  void apply(Eigen::MatrixBase<Derived>& u) const noexcept {
+    assert(u.size() == (n_boundary_cells_ * 2 + n_domain_cells_));
+    const auto nb = n_boundary_cells_;
+    const auto nd = n_domain_cells_;
+    if (inflow_from_left_) {
+      u.head(nb).setConstant(inflow_value_);
+      u.tail(nb).setConstant(u(nb + nd - 1));
+    } else {
+      u.head(nb).setConstant(u(nb));
+      u.tail(nb).setConstant(inflow_value_);
+    }
+  }
+
+ private:
+  int n_boundary_cells_;
+  int n_domain_cells_;
+  bool inflow_from_left_;
+  double inflow_value_;
+};
+
+}  // namespace cfd
+
+#endif  // CFD_BOUNDARY_CONDITIONS_HPP
@@ -1,13 +1,37 @@
 #ifndef CFD_CFD_HPP
 #define CFD_CFD_HPP
 
+#include "cfd/active_region_simulator.hpp"
+#include "cfd/binary_file_io.hpp"
+#include "cfd/boundary_conditions.hpp"
+#include "cfd/discontinuous_galerkin_simulator.hpp"
+#include "cfd/linear_system_simulator.hpp"
+#include "cfd/multi_limiter_simulator.hpp"
+#include "cfd/out_of_core_simulator.hpp"
 #include "cfd/periodic_boundary.hpp"
 #include "cfd/problem_parameters.hpp"
+#include "cfd/problem_parameters_2d.hpp"
+#include "cfd/result_cache.hpp"
 #include "cfd/riemann_solvers.hpp"
 #include "cfd/scalar_advection_equation_simulator.hpp"
+#include "cfd/simulation_state.hpp"
 #include "cfd/slope_limiters.hpp"
 #include "cfd/spacial_reconstruction_schemes.hpp"
+#include "cfd/state_arena.hpp"
 #include "cfd/text_file_writer.hpp"
+#include "cfd/thread_affinity.hpp"
 #include "cfd/time_integration_schemes.hpp"
+#include "cfd/time_step_split.hpp"
+#include "cfd/variable_velocity_advection_equation_simulator.hpp"
+#include "cfd/velocity_field.hpp"
+#include "cfd/version.hpp"
+
+// Simulators parallelized with OpenMP
+#ifdef _OPENMP
+#include "cfd/auto_tuner.hpp"
+#include "cfd/parallel_scalar_advection_equation_simulator.hpp"
+#include "cfd/parareal_simulator.hpp"
+#include "cfd/scalar_advection_equation_simulator_2d.hpp"
+#endif
 
 #endif  // CFD_CFD_HPP
\ No newline at end of file
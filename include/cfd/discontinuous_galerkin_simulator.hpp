@@ -0,0 +1,241 @@
+#ifndef CFD_DISCONTINUOUS_GALERKIN_SIMULATOR_HPP
+#define CFD_DISCONTINUOUS_GALERKIN_SIMULATOR_HPP
+
+#include <Eigen/Core>
+#include <Eigen/LU>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "cfd/problem_parameters.hpp"
+#include "cfd/time_integration_schemes.hpp"
+
+namespace cfd {
+
+/**
+ * @brief Nodal basis of Lagrange polynomials on Gauss-Lobatto-Legendre nodes
+ *
+ * Operators are defined on the reference element @f$ [-1, 1] @f$. They are
+ * derived from the Vandermonde matrix @f$ V_{ij} = \tilde{P}_j(r_i) @f$ of
+ * orthonormal Legendre polynomials @f$ \tilde{P}_j @f$, i.e. the mass matrix
+ * is @f$ M = (V V^T)^{-1} @f$ and the differentiation matrix is
+ * @f$ D = V_r V^{-1} @f$, so that the mass matrix is exact.
+ *
+ * @tparam Order Polynomial order
+ */
+template <int Order>
+class GaussLobattoBasis {
+ public:
+  static_assert(Order >= 1, "Polynomial order must be positive.");
+
+  static constexpr int n_nodes = Order + 1;
+
+  using Vector = Eigen::Matrix<double, n_nodes, 1>;
+  using Matrix = Eigen::Matrix<double, n_nodes, n_nodes>;
+
+  GaussLobattoBasis() {
+    nodes_ = make_nodes();
+    Matrix v, vr;
+    for (int i = 0; i < n_nodes; ++i) {
+      Vector p, dp;
+      legendre(nodes_(i), p, dp);
+      for (int j = 0; j < n_nodes; ++j) {
+        const double scale = std::sqrt(0.5 * (2 * j + 1));
+        v(i, j) = scale * p(j);
+        vr(i, j) = scale * dp(j);
+      }
+    }
+    differentiation_ = vr * v.inverse();
+    inverse_mass_ = v * v.transpose();
+  }
+
+  /// Nodes in ascending order
+  const Vector& nodes() const noexcept { return nodes_; }
+
+  /// Differentiation matrix
+  const Matrix& differentiation() const noexcept { return differentiation_; }
+
+  /// Inverse of the mass matrix
+  const Matrix& inverse_mass() const noexcept { return inverse_mass_; }
+
+ private:
+  /// Legendre polynomials and their derivatives up to Order at r
+  static void legendre(double r, Vector& p, Vector& dp) noexcept {
+    p(0) = 1.0;
+    p(1) = r;
+    dp(0) = 0.0;
+    dp(1) = 1.0;
+    for (int k = 2; k < n_nodes; ++k) {
+      p(k) = ((2 * k - 1) * r * p(k - 1) - (k - 1) * p(k - 2)) / k;
+      dp(k) = dp(k - 2) + (2 * k - 1) * p(k - 1);
+    }
+  }
+
+  /// Roots of @f$ (1 - r^2) P'_N(r) @f$ by the Newton method, starting from
+  /// Chebyshev-Gauss-Lobatto nodes
+  static Vector make_nodes() noexcept {
+    constexpr int n = Order;
+    Vector r;
+    for (int i = 0; i < n_nodes; ++i) {
+      r(i) = -std::cos(M_PI * i / n);
+    }
+    for (int iteration = 0; iteration < 100; ++iteration) {
+      double correction = 0.0;
+      for (int i = 1; i < n; ++i) {
+        double p0 = 1.0;
+        double p1 = r(i);
+        for (int k = 2; k <= n; ++k) {
+          const double p2 = ((2 * k - 1) * r(i) * p1 - (k - 1) * p0) / k;
+          p0 = p1;
+          p1 = p2;
+        }
+        // p1 = P_N, p0 = P_{N-1}
+        const double dr = (r(i) * p1 - p0) / (n_nodes * p1);
+        r(i) -= dr;
+        correction = std::max(correction, std::fabs(dr));
+      }
+      if (correction < 1e-15) {
+        break;
+      }
+    }
+    return r;
+  }
+
+  Vector nodes_;
+  Matrix differentiation_;
+  Matrix inverse_mass_;
+};
+
+/**
+ * @brief Scalar advection equation simulator with the nodal discontinuous
+ * Galerkin method
+ *
+ * Each of n_domain_cells elements of length dx holds the values at Order + 1
+ * Gauss-Lobatto-Legendre nodes, and the strong form
+ * @f[
+ * \frac{du}{dt} = -\frac{2}{\Delta x} \left( a D u -
+ *    M^{-1} \left[ (f - \hat{f}) \ell \right]_{-1}^{1} \right)
+ * @f]
+ * is integrated in time, where @f$ \hat{f} @f$ is numerical flux given by the
+ * Riemann solver from the end values of neighbouring elements. The stencil is
+ * compact, i.e. an element only depends on its immediate neighbours, and
+ * n_boundary_cells is not used. Boundaries are periodic.
+ *
+ * The state is stored as a (# of elements) x (Order + 1) column-major matrix,
+ * so that the values at a node of all elements are contiguous. Element
+ * operators are fixed-size and applied to all elements at once, i.e. column
+ * by column, which is vectorized across elements, and the end values of
+ * elements are passed to the Riemann solver without gathering. The time step
+ * length must satisfy about @f$ |a| \Delta t \le \Delta x / (2 Order + 1) @f$
+ * with SspRungeKutta3Scheme.
+ *
+ * @tparam RiemannSolver Riemann solver
+ * @tparam Order Polynomial order
+ * @tparam TimeIntegrator Time integrator providing advance(u, calc_rhs)
+ */
+template <typename RiemannSolver, int Order,
+          typename TimeIntegrator = SspRungeKutta3Scheme>
+class DiscontinuousGalerkinSimulator {
+ public:
+  using Basis = GaussLobattoBasis<Order>;
+
+  static constexpr int n_nodes = Basis::n_nodes;
+
+  using State = Eigen::Matrix<double, Eigen::Dynamic, n_nodes>;
+
+  /**
+   * @brief Construct a new Discontinuous Galerkin Simulator object
+   *
+   * @param params Problem parameters. n_domain_cells is the number of
+   * elements, and dx is the element length.
+   */
+  DiscontinuousGalerkinSimulator(const ProblemParameters& params)
+      : params_{params}, solver_{params}, integrator_{params} {
+    lift_.col(0) = basis_.inverse_mass().col(0);
+    lift_.col(1) = basis_.inverse_mass().col(Order);
+    differentiation_t_ = basis_.differentiation().transpose();
+  }
+
+  /**
+   * @brief Returns the positions of the nodes
+   *
+   * @param x_left Left end of the domain
+   * @return Eigen::VectorXd Positions of the nodes of all elements, ordered
+   * by element and then by node
+   */
+  Eigen::VectorXd nodes(double x_left) const {
+    const auto ne = params_.n_domain_cells;
+    const double dx = params_.dx;
+    Eigen::VectorXd x(ne * n_nodes);
+    for (int e = 0; e < ne; ++e) {
+      x.segment<n_nodes>(e * n_nodes) =
+          (x_left + dx * e + 0.5 * dx * (basis_.nodes().array() + 1.0))
+              .matrix();
+    }
+    return x;
+  }
+
+  /**
+   * @brief Run simulator
+   *
+   * @tparam Derived
+   * @param u0 Initial values at the nodes, ordered as nodes()
+   * @return Eigen::VectorXd Values at the nodes at the end of time steps.
+   */
+  template <typename Derived>
+  Eigen::VectorXd run(const Eigen::MatrixBase<Derived>& u0) const {
+    using RowMajorState =
+        Eigen::Matrix<double, Eigen::Dynamic, n_nodes, Eigen::RowMajor>;
+    const auto ne = params_.n_domain_cells;
+    assert(u0.size() == ne * n_nodes);
+
+    const Eigen::VectorXd initial = u0;
+    State u = Eigen::Map<const RowMajorState>(initial.data(), ne, n_nodes);
+    const auto calc_rhs = [this](const State& v) { return this->rhs(v); };
+    for (int i = 1; i <= params_.n_timesteps; ++i) {
+      integrator_.advance(u, calc_rhs);
+    }
+
+    Eigen::VectorXd result(ne * n_nodes);
+    Eigen::Map<RowMajorState>(result.data(), ne, n_nodes) = u;
+    return result;
+  }
+
+  /// Basis of elements
+  const Basis& basis() const noexcept { return basis_; }
+
+ private:
+  /// Time derivative of the state
+  State rhs(const State& u) const {
+    using Eigen::VectorXd;
+    const auto ne = params_.n_domain_cells;
+    const double a = params_.velocity;
+
+    // Face j lies between elements j - 1 and j.
+    VectorXd ul(ne);
+    ul(0) = u(ne - 1, Order);
+    ul.tail(ne - 1) = u.col(Order).head(ne - 1);
+    const VectorXd f = solver_.calc_flux(ul, u.col(0));
+    VectorXd fr(ne);
+    fr.head(ne - 1) = f.tail(ne - 1);
+    fr(ne - 1) = f(0);
+
+    State du = a * u.lazyProduct(differentiation_t_);
+    du.noalias() += (fr - a * u.col(Order)) * lift_.col(1).transpose();
+    du.noalias() -= (f - a * u.col(0)) * lift_.col(0).transpose();
+    return (-2.0 / params_.dx) * du;
+  }
+
+  ProblemParameters params_;
+  Basis basis_;
+  RiemannSolver solver_;
+  TimeIntegrator integrator_;
+  Eigen::Matrix<double, n_nodes, 2> lift_;  ///> Columns of the inverse mass
+                                            ///> matrix at the element ends
+  typename Basis::Matrix differentiation_t_;  ///> Transposed
+                                             ///> differentiation matrix
+};
+
+}  // namespace cfd
+
+#endif  // CFD_DISCONTINUOUS_GALERKIN_SIMULATOR_HPP
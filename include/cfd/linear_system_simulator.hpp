@@ -0,0 +1,372 @@
+#ifndef CFD_LINEAR_SYSTEM_SIMULATOR_HPP
+#define CFD_LINEAR_SYSTEM_SIMULATOR_HPP
+
+#include <Eigen/Core>
+#include <Eigen/Eigenvalues>
+#include <Eigen/LU>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "cfd/periodic_boundary.hpp"
+#include "cfd/problem_parameters.hpp"
+#include "cfd/state_arena.hpp"
+#include "cfd/time_integration_schemes.hpp"
+
+namespace cfd {
+
+/**
+ * @brief Array-of-structures layout of a system state
+ *
+ * The state is a (m, n) matrix, so the m components of a cell are contiguous.
+ */
+struct AosLayout {
+  template <int M>
+  using Storage = Eigen::Matrix<double, M, Eigen::Dynamic>;
+
+  using Cells = CellsAsColumns;
+
+  /// Whether each component is contiguous, i.e. binds to a vector reference
+  static constexpr bool contiguous_components = false;
+
+  template <int M>
+  static Storage<M> allocate(int n_cells) {
+    return Storage<M>(M, n_cells);
+  }
+
+  template <typename Derived>
+  static auto component(Eigen::MatrixBase<Derived>& u, int k) noexcept {
+    return u.row(k).transpose();
+  }
+
+  template <typename Derived>
+  static auto component(const Eigen::MatrixBase<Derived>& u, int k) noexcept {
+    return u.row(k).transpose();
+  }
+
+  template <typename Derived1, typename Derived2, typename Derived3>
+  static void transform(const Eigen::MatrixBase<Derived1>& t,
+                        const Eigen::MatrixBase<Derived2>& u,
+                        Eigen::MatrixBase<Derived3>& v) noexcept {
+    v.noalias() = t * u;
+  }
+
+  /// Transform cell by cell as v = t1 u1 + t2 u2
+  template <typename Derived1, typename Derived2, typename Derived3,
+            typename Derived4, typename Derived5>
+  static void transform(const Eigen::MatrixBase<Derived1>& t1,
+                        const Eigen::MatrixBase<Derived2>& u1,
+                        const Eigen::MatrixBase<Derived3>& t2,
+                        const Eigen::MatrixBase<Derived4>& u2,
+                        Eigen::MatrixBase<Derived5>& v) noexcept {
+    v.noalias() = t1 * u1;
+    v.noalias() += t2 * u2;
+  }
+
+  template <int M, typename Derived>
+  static Eigen::Matrix<double, M, Eigen::Dynamic> to_cells(
+      const Eigen::MatrixBase<Derived>& u) {
+    return u;
+  }
+
+  template <int M, typename Derived>
+  static Storage<M> from_cells(const Eigen::MatrixBase<Derived>& u) {
+    return u;
+  }
+};
+
+/**
+ * @brief Structure-of-arrays layout of a system state
+ *
+ * The state is a (n, m) matrix, so each component is contiguous.
+ */
+struct SoaLayout {
+  template <int M>
+  using Storage = Eigen::Matrix<double, Eigen::Dynamic, M>;
+
+  using Cells = CellsAsRows;
+
+  /// Whether each component is contiguous, i.e. binds to a vector reference
+  static constexpr bool contiguous_components = true;
+
+  template <int M>
+  static Storage<M> allocate(int n_cells) {
+    return Storage<M>(n_cells, M);
+  }
+
+  template <typename Derived>
+  static auto component(Eigen::MatrixBase<Derived>& u, int k) noexcept {
+    return u.col(k);
+  }
+
+  template <typename Derived>
+  static auto component(const Eigen::MatrixBase<Derived>& u, int k) noexcept {
+    return u.col(k);
+  }
+
+  template <typename Derived1, typename Derived2, typename Derived3>
+  static void transform(const Eigen::MatrixBase<Derived1>& t,
+                        const Eigen::MatrixBase<Derived2>& u,
+                        Eigen::MatrixBase<Derived3>& v) noexcept {
+    v.noalias() = u * t.transpose();
+  }
+
+  /// Transform cell by cell as v = t1 u1 + t2 u2
+  template <typename Derived1, typename Derived2, typename Derived3,
+            typename Derived4, typename Derived5>
+  static void transform(const Eigen::MatrixBase<Derived1>& t1,
+                        const Eigen::MatrixBase<Derived2>& u1,
+                        const Eigen::MatrixBase<Derived3>& t2,
+                        const Eigen::MatrixBase<Derived4>& u2,
+                        Eigen::MatrixBase<Derived5>& v) noexcept {
+    v.noalias() = u1 * t1.transpose();
+    v.noalias() += u2 * t2.transpose();
+  }
+
+  template <int M, typename Derived>
+  static Eigen::Matrix<double, M, Eigen::Dynamic> to_cells(
+      const Eigen::MatrixBase<Derived>& u) {
+    return u.transpose();
+  }
+
+  template <int M, typename Derived>
+  static Storage<M> from_cells(const Eigen::MatrixBase<Derived>& u) {
+    return u.transpose();
+  }
+};
+
+/**
+ * @brief Eigen-decomposition of the flux Jacobian of a linear hyperbolic
+ * system
+ *
+ * @f[
+ * A = R \Lambda L, \quad L = R^{-1}
+ * @f]
+ * where the columns of @f$ R @f$ are right eigenvectors and @f$ \Lambda @f$ is
+ * the diagonal matrix of (real) eigenvalues.
+ */
+template <int M>
+class CharacteristicDecomposition {
+ public:
+  using Matrix = Eigen::Matrix<double, M, M>;
+  using Vector = Eigen::Matrix<double, M, 1>;
+
+  /**
+   * @brief Construct a new Characteristic Decomposition object
+   *
+   * @param a Flux Jacobian, which must be diagonalizable with real eigenvalues
+   */
+  CharacteristicDecomposition(const Matrix& a) {
+    const Eigen::EigenSolver<Matrix> solver(a);
+    assert(solver.info() == Eigen::Success);
+    assert(solver.eigenvalues().imag().cwiseAbs().maxCoeff() <=
+               1e-12 * (1 + a.cwiseAbs().maxCoeff()) &&
+           "A linear hyperbolic system requires real eigenvalues.");
+    eigenvalues_ = solver.eigenvalues().real();
+    right_ = solver.eigenvectors().real();
+    // Eigenvectors have unit norm, so a small pivot relative to the largest
+    // one means that they are nearly parallel, i.e. A is defective.
+    Eigen::FullPivLU<Matrix> lu(right_);
+    lu.setThreshold(1e-8);
+    assert(lu.isInvertible() &&
+           "A linear hyperbolic system requires a diagonalizable flux "
+           "Jacobian.");
+    left_ = lu.inverse();
+  }
+
+  const Vector& eigenvalues() const noexcept { return eigenvalues_; }
+
+  /// Right eigenvectors as columns
+  const Matrix& right() const noexcept { return right_; }
+
+  /// Left eigenvectors as rows
+  const Matrix& left() const noexcept { return left_; }
+
+ private:
+  Vector eigenvalues_;
+  Matrix right_;
+  Matrix left_;
+};
+
+/**
+ * @brief Simulator of a linear hyperbolic system
+ *
+ * @f[
+ * \frac{\partial \mathbf{u}}{\partial t} +
+ *    A \frac{\partial \mathbf{u}}{\partial x} = 0
+ * @f]
+ * where each cell holds a vector of size @f$ m @f$.
+ *
+ * Every stage, the state is transformed into characteristic variables
+ * @f$ \mathbf{w} = L \mathbf{u} @f$. Each characteristic field is
+ * reconstructed by the scalar spacial reconstructor with its eigenvalue as
+ * velocity, so that slope limiting is done in characteristic variables. Face
+ * values are kept in the layout of the state, and the Roe flux
+ * @f[
+ * \hat{\mathbf{f}} = R \Lambda^+ \mathbf{w}_L + R \Lambda^- \mathbf{w}_R
+ * @f]
+ * is then computed cell by cell in one pass, where
+ * @f$ \Lambda^\pm = (\Lambda \pm |\Lambda|) / 2 @f$. All buffers, including
+ * the stage buffers of the time integrator, are allocated once per run.
+ *
+ * @tparam M Number of components per cell
+ * @tparam SpacialReconstructor Scalar spacial reconstructor
+ * @tparam Layout AosLayout or SoaLayout
+ * @tparam TimeIntegrator ExplicitEulerScheme, or SspRungeKutta3Scheme with a
+ * reconstructor which does not depend on the time step length, i.e.
+ * FirstOrderSpacialReconstructor or Weno5SpacialReconstructor. TVD and other
+ * reconstructors using the Courant number must use ExplicitEulerScheme.
+ * @tparam Boundary Boundary conditions applied to each component, e.g.
+ * PeriodicBoundary, DirichletBoundary, or OutflowBoundary
+ */
+template <int M, typename SpacialReconstructor, typename Layout = AosLayout,
+          typename TimeIntegrator = ExplicitEulerScheme,
+          typename Boundary = PeriodicBoundary>
+class LinearSystemSimulator {
+ public:
+  using Storage = typename Layout::template Storage<M>;
+
+  /**
+   * @brief Construct a new Linear System Simulator object
+   *
+   * @param params Problem parameters. The scalar velocity is not used.
+   * @param a Flux Jacobian
+   */
+  LinearSystemSimulator(const ProblemParameters& params,
+                        const Eigen::Matrix<double, M, M>& a)
+      : LinearSystemSimulator{params, a, Boundary{params}} {}
+
+  /**
+   * @brief Construct a new Linear System Simulator object with boundary
+   * conditions applied to each component
+   *
+   * @param params Problem parameters. The scalar velocity is not used.
+   * @param a Flux Jacobian
+   * @param boundary Boundary conditions
+   */
+  LinearSystemSimulator(const ProblemParameters& params,
+                        const Eigen::Matrix<double, M, M>& a,
+                        const Boundary& boundary)
+      : n_boundary_cells_{params.n_boundary_cells},
+        n_domain_cells_{params.n_domain_cells},
+        n_timesteps_{params.n_timesteps},
+        decomposition_{a},
+        integrator_{params},
+        boundary_{boundary} {
+    reconstructors_.reserve(M);
+    for (int k = 0; k < M; ++k) {
+      auto field_params = params;
+      field_params.velocity = decomposition_.eigenvalues()(k);
+      reconstructors_.emplace_back(field_params);
+    }
+    const auto& lambda = decomposition_.eigenvalues();
+    flux_left_ = decomposition_.right() * lambda.cwiseMax(0.0).asDiagonal();
+    flux_right_ = decomposition_.right() * lambda.cwiseMin(0.0).asDiagonal();
+  }
+
+  /**
+   * @brief Run simulator
+   *
+   * @tparam Derived
+   * @param u0 Initial condition of size (m, # of domain cells)
+   * @return Eigen::Matrix<double, M, Eigen::Dynamic> Values at the end of time
+   * steps.
+   */
+  template <typename Derived>
+  Eigen::Matrix<double, M, Eigen::Dynamic> run(
+      const Eigen::MatrixBase<Derived>& u0) const {
+    assert(u0.rows() == M && u0.cols() == n_domain_cells_);
+    using Eigen::seqN;
+
+    const auto nb = n_boundary_cells_;
+    const auto nd = n_domain_cells_;
+    const auto& l = decomposition_.left();
+
+    Eigen::Matrix<double, M, Eigen::Dynamic> u_cells(M, nb * 2 + nd);
+    u_cells(Eigen::all, seqN(nb, nd)) = u0;
+    Storage u = Layout::template from_cells<M>(u_cells);
+    Storage w = Layout::template allocate<M>(nb * 2 + nd);
+    Storage wl = Layout::template allocate<M>(nd + 1);
+    Storage wr = Layout::template allocate<M>(nd + 1);
+    Storage f = Layout::template allocate<M>(nd + 1);
+    std::array<Storage, TimeIntegrator::n_stage_buffers> stages;
+    for (auto& stage : stages) {
+      stage = Layout::template allocate<M>(nb * 2 + nd);
+    }
+    // Scratch buffers of the reconstructor and a face line for layouts whose
+    // components are strided
+    constexpr int n_buffers = SpacialReconstructor::n_arena_buffers + 1;
+    StateArena arena;
+    arena.reserve(Eigen::Index{n_buffers} * (nb * 2 + nd), n_buffers);
+    // Fluxes are computed into the same buffer every stage, which the time
+    // integrator consumes before the next one
+    const auto calc_flux = [&](const auto& v) -> const Storage& {
+      Layout::transform(l, v, w);
+      for (int k = 0; k < M; ++k) {
+        this->reconstruct(k, Layout::component(w, k), wl, wr, arena);
+      }
+      Layout::transform(flux_left_, wl, flux_right_, wr, f);
+      return f;
+    };
+    const auto apply_boundary = [this](auto& v) {
+      this->apply_boundary(v.derived());
+    };
+
+    this->apply_boundary(u);
+    for (int i = 1; i <= n_timesteps_; ++i) {
+      integrator_.advance(u, calc_flux, apply_boundary,
+                          typename Layout::Cells{}, stages);
+    }
+
+    u_cells = Layout::template to_cells<M>(u);
+    return u_cells(Eigen::all, seqN(nb, nd));
+  }
+
+  const CharacteristicDecomposition<M>& decomposition() const noexcept {
+    return decomposition_;
+  }
+
+ private:
+  using Matrix = Eigen::Matrix<double, M, M>;
+
+  /// Reconstruct the k-th characteristic field wk into the k-th components of
+  /// wl and wr
+  template <typename Derived>
+  void reconstruct(int k, const Eigen::MatrixBase<Derived>& wk, Storage& wl,
+                   Storage& wr, StateArena& arena) const {
+    const auto& reconstructor = reconstructors_[k];
+    if constexpr (Layout::contiguous_components) {
+      reconstructor.calc_left(wk, Layout::component(wl, k), arena);
+      reconstructor.calc_right(wk, Layout::component(wr, k), arena);
+    } else {
+      StateArena::Scope scope{arena};
+      auto line = arena.allocate(n_domain_cells_ + 1);
+      reconstructor.calc_left(wk, line, arena);
+      Layout::component(wl, k) = line;
+      reconstructor.calc_right(wk, line, arena);
+      Layout::component(wr, k) = line;
+    }
+  }
+
+  void apply_boundary(Storage& u) const noexcept {
+    for (int k = 0; k < M; ++k) {
+      auto uk = Layout::component(u, k);
+      boundary_.apply(uk);
+    }
+  }
+
+  int n_boundary_cells_;
+  int n_domain_cells_;
+  int n_timesteps_;
+  CharacteristicDecomposition<M> decomposition_;
+  std::vector<SpacialReconstructor> reconstructors_;
+  Matrix flux_left_;   ///> R times the positive part of eigenvalues
+  Matrix flux_right_;  ///> R times the negative part of eigenvalues
+  TimeIntegrator integrator_;
+  Boundary boundary_;
+};
+
+}  // namespace cfd
+
+#endif  // CFD_LINEAR_SYSTEM_SIMULATOR_HPP
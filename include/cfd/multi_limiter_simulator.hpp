@@ -0,0 +1,201 @@
+#ifndef CFD_MULTI_LIMITER_SIMULATOR_HPP
+#define CFD_MULTI_LIMITER_SIMULATOR_HPP
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cassert>
+#include <tuple>
+#include <utility>
+
+#include "cfd/problem_parameters.hpp"
+#include "cfd/time_integration_schemes.hpp"
+
+namespace cfd {
+
+/**
+ * @brief Simulator advancing TVD schemes with several slope limiters side by
+ * side
+ *
+ * The states of all variants are interleaved, i.e. stored as a K x (# of total
+ * cells) column-major matrix for K limiters, so that the values of a cell are
+ * adjacent in memory. Faces are processed tile by tile: differences of
+ * neighbouring cells and the denominators of the slope ratios of a tile are
+ * computed once for all variants and shared by the left and right
+ * reconstructions, and then each limiter is applied to its own row. Tiles are
+ * allocated once per run. The time integrator advances all variants at once,
+ * and boundary conditions are applied to each variant, so that each variant
+ * gives the same results as ScalarAdvectionEquationSimulator with
+ * TvdSpacialReconstructor and its limiter.
+ *
+ * @tparam RiemannSolver Riemann solver
+ * @tparam TimeIntegrator ExplicitEulerScheme, since the TVD reconstruction
+ * depends on the time step length through the Courant number
+ * @tparam Boundary PeriodicBoundary, DirichletBoundary, OutflowBoundary,
+ * ReflectiveBoundary, or InflowOutflowBoundary
+ * @tparam Limiters Slope limiters
+ */
+template <typename RiemannSolver, typename TimeIntegrator, typename Boundary,
+          typename... Limiters>
+class MultiLimiterSimulator {
+ public:
+  static constexpr int n_variants = sizeof...(Limiters);
+
+  using State = Eigen::Matrix<double, n_variants, Eigen::Dynamic>;
+  using Result = Eigen::Matrix<double, Eigen::Dynamic, n_variants>;
+
+  /**
+   * @brief Construct a new Multi Limiter Simulator object
+   *
+   * @param params Problem parameters
+   * @param tile_size Number of faces of a tile
+   */
+  MultiLimiterSimulator(const ProblemParameters& params, int tile_size = 512)
+      : MultiLimiterSimulator{params, Boundary{params}, tile_size} {}
+
+  /**
+   * @brief Construct a new Multi Limiter Simulator object with boundary
+   * conditions applied to each variant
+   *
+   * @param params Problem parameters
+   * @param boundary Boundary conditions
+   * @param tile_size Number of faces of a tile
+   */
+  MultiLimiterSimulator(const ProblemParameters& params,
+                        const Boundary& boundary, int tile_size = 512)
+      : params_{params},
+        solver_{params},
+        integrator_{params},
+        boundary_{boundary},
+        tile_size_{tile_size} {
+    assert(params.n_boundary_cells >= 2 &&
+           "TVD method requires (# of boundary cells >= 2).");
+    assert(tile_size >= 1);
+  }
+
+  /**
+   * @brief Run simulator
+   *
+   * @tparam Derived
+   * @param u0 Initial condition shared by all variants
+   * @return Result Values at the end of time steps. Column k is the result of
+   * the k-th limiter.
+   */
+  template <typename Derived>
+  Result run(const Eigen::MatrixBase<Derived>& u0) const {
+    const auto nb = params_.n_boundary_cells;
+    const auto nd = params_.n_domain_cells;
+
+    State u(n_variants, params_.n_total_cells());
+    u.middleCols(nb, nd) = u0.transpose().replicate(n_variants, 1);
+    // Fluxes are computed into the same buffer every stage, which the time
+    // integrator consumes before the next one
+    State f(n_variants, nd + 1);
+    Tiles tiles(std::min(tile_size_, nd + 1));
+    const auto calc_flux = [this, &f, &tiles](const auto& v) -> const State& {
+      this->calc_flux(v.derived(), f, tiles);
+      return f;
+    };
+    const auto apply_boundary = [this](auto& v) {
+      this->apply_boundary(v.derived());
+    };
+
+    this->apply_boundary(u);
+    for (int i = 1; i <= params_.n_timesteps; ++i) {
+      integrator_.advance(u, calc_flux, apply_boundary, CellsAsColumns{});
+    }
+    return u.middleCols(nb, nd).transpose();
+  }
+
+ private:
+  /// Tile of all variants, whose rows are contiguous so that limiters and the
+  /// Riemann solver write into them directly
+  using Tile =
+      Eigen::Matrix<double, n_variants, Eigen::Dynamic, Eigen::RowMajor>;
+
+  /// Tiles of a run, of which a tile of n faces uses the first n columns
+  struct Tiles {
+    Tiles(int tile_size)
+        : du(n_variants, tile_size + 2),
+          denominator(n_variants, tile_size),
+          rl(n_variants, tile_size),
+          rr(n_variants, tile_size),
+          phil(n_variants, tile_size),
+          phir(n_variants, tile_size),
+          ul(n_variants, tile_size),
+          ur(n_variants, tile_size),
+          f(n_variants, tile_size) {}
+
+    Tile du, denominator, rl, rr, phil, phir, ul, ur, f;
+  };
+
+  void apply_boundary(State& u) const noexcept {
+    for (int k = 0; k < n_variants; ++k) {
+      auto uk = u.row(k);
+      boundary_.apply(uk);
+    }
+  }
+
+  /// Numerical fluxes of all variants at all faces
+  void calc_flux(const State& u, State& f, Tiles& t) const noexcept {
+    const auto nb = params_.n_boundary_cells;
+    const auto nd = params_.n_domain_cells;
+    const double courant = params_.velocity * params_.dt / params_.dx;
+
+    for (int begin = 0; begin < nd + 1; begin += tile_size_) {
+      const int n = std::min(tile_size_, nd + 1 - begin);
+      // du(m) = u(j - 1) - u(j - 2) for j = nb + begin + m, i.e. the
+      // differences around faces from begin - 1 to begin + n.
+      auto du = t.du.leftCols(n + 2);
+      auto denominator = t.denominator.leftCols(n);
+      auto rl = t.rl.leftCols(n);
+      auto rr = t.rr.leftCols(n);
+      auto phil = t.phil.leftCols(n);
+      auto phir = t.phir.leftCols(n);
+      auto ul = t.ul.leftCols(n);
+      auto ur = t.ur.leftCols(n);
+      du = u.middleCols(nb - 1 + begin, n + 2) -
+           u.middleCols(nb - 2 + begin, n + 2);
+      denominator =
+          du.middleCols(1, n) + du.middleCols(1, n).unaryExpr([](double x) {
+            return x >= 0 ? 1e-5 : -1e-5;
+          });
+      rl = du.leftCols(n).cwiseQuotient(denominator);
+      rr = du.rightCols(n).cwiseQuotient(denominator);
+      limit(rl, phil, std::index_sequence_for<Limiters...>{});
+      limit(rr, phir, std::index_sequence_for<Limiters...>{});
+
+      const auto delta = 0.5 * du.middleCols(1, n).array();
+      ul = (u.middleCols(nb - 1 + begin, n).array() +
+            (1 - courant) * (phil.array() * delta))
+               .matrix();
+      ur = (u.middleCols(nb + begin, n).array() -
+            (1 + courant) * (phir.array() * delta))
+               .matrix();
+      for (int k = 0; k < n_variants; ++k) {
+        solver_.calc_flux(ul.row(k).transpose(), ur.row(k).transpose(),
+                          t.f.row(k).head(n).transpose());
+      }
+      f.middleCols(begin, n) = t.f.leftCols(n);
+    }
+  }
+
+  /// Apply the k-th limiter to the k-th row
+  template <typename Derived1, typename Derived2, std::size_t... K>
+  static void limit(const Eigen::MatrixBase<Derived1>& r,
+                    Eigen::MatrixBase<Derived2>& phi,
+                    std::index_sequence<K...>) noexcept {
+    (std::tuple_element_t<K, std::tuple<Limiters...>>::eval(
+         r.row(K).transpose(), phi.row(K).transpose()),
+     ...);
+  }
+
+  ProblemParameters params_;
+  RiemannSolver solver_;
+  TimeIntegrator integrator_;
+  Boundary boundary_;
+  int tile_size_;
+};
+
+}  // namespace cfd
+
+#endif  // CFD_MULTI_LIMITER_SIMULATOR_HPP
@@ -0,0 +1,270 @@
+#ifndef CFD_OUT_OF_CORE_SIMULATOR_HPP
+#define CFD_OUT_OF_CORE_SIMULATOR_HPP
+
+#include <fmt/core.h>
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <string>
+
+#include "cfd/binary_file_io.hpp"
+#include "cfd/problem_parameters.hpp"
+
+namespace cfd {
+
+/**
+ * @brief Options of out-of-core runs
+ */
+struct OutOfCoreOptions {
+  int chunk_cells = 1 << 20;  ///> Number of domain cells of a chunk
+  int steps_per_pass = 8;     ///> Number of time steps per chunk load
+};
+
+/**
+ * @brief Report of an out-of-core run
+ */
+struct OutOfCoreReport {
+  int passes = 0;                ///> Number of passes over the state
+  long long chunk_loads = 0;     ///> Number of chunks loaded
+  double bytes_read = 0.0;       ///> Bytes read including halos
+  double bytes_written = 0.0;    ///> Bytes written
+  double seconds = 0.0;          ///> Wall time
+  double io_wait_seconds = 0.0;  ///> Time spent waiting for I/O
+};
+
+/**
+ * @brief Scalar advection equation simulator with the state kept in files
+ *
+ * The state is streamed through memory in chunks of domain cells. A chunk is
+ * loaded with halos of n_boundary_cells * steps_per_pass cells on both sides,
+ * advanced by steps_per_pass time steps, during which the valid cells shrink by
+ * n_boundary_cells per side and time step, and its domain cells are written to
+ * the output file of the pass. Reading the next chunk and writing the previous
+ * one run asynchronously while a chunk is advanced.
+ *
+ * Boundaries are periodic, i.e. halos wrap around the domain ends, and the
+ * results are identical to those of ScalarAdvectionEquationSimulator. Files are
+ * binary files of BinaryFileFormat, and passes alternate between two work
+ * files next to the output file. Only the input file is mapped, and it is read
+ * sequentially, so its pages can be evicted without swapping.
+ *
+ * The time integrator must be single-stage, i.e. provide update(u, f).
+ */
+template <typename RiemannSolver, typename SpacialReconstructor,
+          typename TimeIntegrator>
+class OutOfCoreSimulator {
+ public:
+  /**
+   * @brief Construct a new Out Of Core Simulator object
+   *
+   * @param params Problem parameters
+   * @param options Out-of-core options
+   */
+  OutOfCoreSimulator(const ProblemParameters& params,
+                     const OutOfCoreOptions& options = {})
+      : params_{params}, options_{options} {
+    assert(options.chunk_cells >= 1 && options.steps_per_pass >= 1);
+  }
+
+  /**
+   * @brief Run simulator
+   *
+   * @param u0_path Binary file of the initial condition
+   * @param uN_path Binary file to output values at the end of time steps
+   * @param report Report of the run, if not null
+   */
+  void run(const std::filesystem::path& u0_path,
+           const std::filesystem::path& uN_path,
+           OutOfCoreReport* report = nullptr) const {
+    namespace fs = std::filesystem;
+
+    using Clock = std::chrono::steady_clock;
+
+    OutOfCoreReport r;
+    const auto start = Clock::now();
+    const fs::path work_paths[] = {fs::path(uN_path).concat(".0.tmp"),
+                                   fs::path(uN_path).concat(".1.tmp")};
+
+    auto input = BinaryFileReader{u0_path.parent_path()}.read(
+        u0_path.filename().string(), params_);
+    int n_remaining = params_.n_timesteps;
+    do {
+      const int n_steps = std::min(options_.steps_per_pass, n_remaining);
+      n_remaining -= n_steps;
+      const auto& output =
+          n_remaining == 0 ? uN_path : work_paths[r.passes % 2];
+      this->pass(input, output, n_steps, r);
+      r.passes += 1;
+      if (n_remaining > 0) {
+        input = BinaryFileReader{output.parent_path()}.read(
+            output.filename().string(), params_);
+      }
+    } while (n_remaining > 0);
+
+    for (const auto& path : work_paths) {
+      std::error_code ec;
+      fs::remove(path, ec);
+    }
+    r.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (report) {
+      *report = r;
+    }
+  }
+
+ private:
+  using Format = BinaryFileFormat;
+
+  /// Advance all chunks of the state by n_steps time steps
+  void pass(const MappedVector& input, const std::filesystem::path& output,
+            int n_steps, OutOfCoreReport& report) const {
+    using Eigen::VectorXd;
+
+    const auto nb = params_.n_boundary_cells;
+    const auto nd = params_.n_domain_cells;
+    // The last chunk also takes the remaining cells, so that every chunk has
+    // at least n_boundary_cells cells.
+    const int chunk_cells = std::min(std::max(options_.chunk_cells, nb), nd);
+    const int n_chunks = nd / chunk_cells;
+    const int halo = nb * n_steps;
+
+    create_file(output);
+    VectorXd in[2];
+    VectorXd out[2];
+    std::future<void> read;
+    std::future<bool> write[2];
+
+    const auto chunk_size = [&](int c) {
+      return c == n_chunks - 1 ? nd - c * chunk_cells : chunk_cells;
+    };
+    const auto load = [&](int c) {
+      auto& buffer = in[c % 2];
+      buffer.resize(chunk_size(c) + 2 * halo);
+      return std::async(std::launch::async, [&input, &buffer, c, halo, nd,
+                                             chunk_cells] {
+        gather(input.values(), c * chunk_cells - halo, buffer, nd);
+      });
+    };
+    const auto wait = [&report](auto& future) {
+      using Clock = std::chrono::steady_clock;
+      const auto start = Clock::now();
+      future.wait();
+      report.io_wait_seconds +=
+          std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    read = load(0);
+    for (int c = 0; c < n_chunks; ++c) {
+      wait(read);
+      read.get();
+      auto& buffer = in[c % 2];
+      report.chunk_loads += 1;
+      report.bytes_read += sizeof(double) * buffer.size();
+      if (c + 1 < n_chunks) {
+        read = load(c + 1);
+      }
+
+      this->advance(buffer, n_steps);
+
+      auto& pending = write[c % 2];
+      if (pending.valid()) {
+        wait(pending);
+        check(pending.get(), output);
+      }
+      const int len = chunk_size(c);
+      out[c % 2] = buffer.segment(halo, len);
+      report.bytes_written += sizeof(double) * len;
+      pending = std::async(
+          std::launch::async,
+          [&output, &values = out[c % 2], offset = c * chunk_cells] {
+            return write_values(output, offset, values);
+          });
+    }
+    for (auto& pending : write) {
+      if (pending.valid()) {
+        wait(pending);
+        check(pending.get(), output);
+      }
+    }
+  }
+
+  /// Advance a chunk with its halos, whose outermost cells serve as boundary
+  /// cells and are never updated
+  void advance(Eigen::VectorXd& u, int n_steps) const noexcept {
+    using Eigen::VectorXd;
+    if (n_steps == 0) {
+      return;
+    }
+    auto local_params = params_;
+    local_params.n_domain_cells =
+        static_cast<int>(u.size()) - 2 * params_.n_boundary_cells;
+    const RiemannSolver solver{local_params};
+    const SpacialReconstructor reconstructor{local_params};
+    const TimeIntegrator integrator{local_params};
+    for (int i = 1; i <= n_steps; ++i) {
+      const VectorXd ul = reconstructor.calc_left(u);
+      const VectorXd ur = reconstructor.calc_right(u);
+      const VectorXd f = solver.calc_flux(ul, ur);
+      integrator.update(u, f);
+    }
+  }
+
+  /// Copy cells from first on, wrapping around the domain ends
+  static void gather(const MappedVector::ConstMap& src, int first,
+                     Eigen::VectorXd& dst, int n_domain_cells) noexcept {
+    int i = ((first % n_domain_cells) + n_domain_cells) % n_domain_cells;
+    Eigen::Index k = 0;
+    while (k < dst.size()) {
+      const auto n = std::min<Eigen::Index>(n_domain_cells - i, dst.size() - k);
+      dst.segment(k, n) = src.segment(i, n);
+      k += n;
+      i = 0;
+    }
+  }
+
+  /// Create a file of the domain cells with a header
+  void create_file(const std::filesystem::path& path) const {
+    const auto n = static_cast<std::uint64_t>(params_.n_domain_cells);
+    {
+      std::ofstream file(path, std::ios::binary | std::ios::trunc);
+      file.write(Format::magic, sizeof(Format::magic));
+      file.write(reinterpret_cast<const char*>(&n), sizeof(n));
+      check(static_cast<bool>(file), path);
+    }
+    std::error_code ec;
+    std::filesystem::resize_file(path, Format::header_size + n * sizeof(double),
+                                 ec);
+    check(!ec, path);
+  }
+
+  /// Write values to a file from a cell offset
+  static bool write_values(const std::filesystem::path& path, int offset,
+                           const Eigen::VectorXd& values) noexcept {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(static_cast<std::streamoff>(Format::header_size +
+                                           sizeof(double) * offset));
+    file.write(reinterpret_cast<const char*>(values.data()),
+               static_cast<std::streamsize>(sizeof(double) * values.size()));
+    return static_cast<bool>(file);
+  }
+
+  static void check(bool ok, const std::filesystem::path& path) noexcept {
+    if (!ok) {
+      fmt::print(stderr, "Failed to write a binary file: {}\n", path.string());
+      std::exit(EXIT_FAILURE);
+    }
+  }
+
+  ProblemParameters params_;
+  OutOfCoreOptions options_;
+};
+
+}  // namespace cfd
+
+#endif  // CFD_OUT_OF_CORE_SIMULATOR_HPP
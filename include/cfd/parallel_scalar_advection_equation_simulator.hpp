@@ -0,0 +1,253 @@
+#ifndef CFD_PARALLEL_SCALAR_ADVECTION_EQUATION_SIMULATOR_HPP
+#define CFD_PARALLEL_SCALAR_ADVECTION_EQUATION_SIMULATOR_HPP
+
+#include <omp.h>
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <exception>
+#include <map>
+#include <vector>
+
+#include "cfd/boundary_conditions.hpp"
+#include "cfd/periodic_boundary.hpp"
+#include "cfd/problem_parameters.hpp"
+#include "cfd/thread_affinity.hpp"
+
+namespace cfd {
+
+/**
+ * @brief Options of parallel runs
+ */
+struct ThreadingOptions {
+  int n_threads = 0;        ///> Number of threads (0: OpenMP default)
+  bool pin_threads = true;  ///> Whether to pin threads to logical CPUs
+};
+
+/**
+ * @brief Effective memory bandwidth achieved by threads on one socket
+ *
+ * Traffic is modeled as reading and writing the owned slice of the state once
+ * per time step. Time is measured per thread excluding waits at barriers, and
+ * the socket takes the longest time of its threads.
+ */
+struct SocketBandwidth {
+  int socket;      ///> Socket ID
+  int n_threads;   ///> Number of threads on the socket
+  double bytes;    ///> Modeled traffic in bytes
+  double seconds;  ///> Busy time of the slowest thread in seconds
+
+  double gigabytes_per_second() const noexcept {
+    return seconds > 0 ? bytes / seconds * 1e-9 : 0.0;
+  }
+};
+
+/**
+ * @brief Report of a parallel run
+ */
+struct ParallelRunReport {
+  std::vector<int> thread_cpus;  ///> Logical CPU of each thread (-1: unpinned)
+  std::vector<SocketBandwidth> sockets;  ///> Bandwidth per socket
+  double seconds = 0.0;                  ///> Wall time of time steps
+};
+
+/**
+ * @brief Scalar advection equation simulator parallelized over subdomains
+ *
+ * The domain is split into contiguous slices, one per OpenMP thread. Each
+ * thread is optionally pinned to a logical CPU, writes the initial values of
+ * its own slice, so that its pages are first touched on the thread's NUMA
+ * node, and advances only its own slice afterwards. A slice is advanced by the
+ * usual spacial reconstructor, Riemann solver and time integrator applied to a
+ * view of the slice with its neighbouring cells as boundary cells.
+ *
+ * The time integrator must be single-stage, i.e. provide update(u, f).
+ */
+template <typename RiemannSolver, typename SpacialReconstructor,
+          typename TimeIntegrator, typename Boundary = PeriodicBoundary>
+class ParallelScalarAdvectionEquationSimulator {
+ public:
+  /**
+   * @brief Construct a new Parallel Scalar Advection Equation Simulator object
+   *
+   * @param params Problem parameters
+   * @param options Threading options
+   */
+  ParallelScalarAdvectionEquationSimulator(const ProblemParameters& params,
+                                           const ThreadingOptions& options = {})
+      : params_{params}, options_{options}, boundary_{params} {}
+
+  /**
+   * @brief Construct a new Parallel Scalar Advection Equation Simulator object
+   *
+   * @param params Problem parameters
+   * @param boundary Boundary conditions
+   * @param options Threading options
+   */
+  ParallelScalarAdvectionEquationSimulator(const ProblemParameters& params,
+                                           const Boundary& boundary,
+                                           const ThreadingOptions& options = {})
+      : params_{params}, options_{options}, boundary_{boundary} {}
+
+  /**
+   * @brief Run simulator
+   *
+   * @tparam Derived
+   * @param u0 Initial condition
+   * @param report Report of the run, if not null
+   * @return Eigen::VectorXd Values at the end of time steps.
+   */
+  template <typename Derived>
+  Eigen::VectorXd run(const Eigen::MatrixBase<Derived>& u0,
+                      ParallelRunReport* report = nullptr) const {
+    using Eigen::seqN;
+    using Eigen::VectorXd;
+
+    const auto nb = params_.n_boundary_cells;
+    const auto nd = params_.n_domain_cells;
+    const int n_threads = std::min(
+        options_.n_threads > 0 ? options_.n_threads : omp_get_max_threads(),
+        nd);
+    const auto cpus =
+        options_.pin_threads ? available_cpus() : std::vector<int>{};
+
+    // Not initialized, so that pages are first touched by their owners below.
+    VectorXd u(params_.n_total_cells());
+    std::vector<int> thread_cpus;
+    std::vector<double> busy_seconds;
+    int n_team = 0;
+    double seconds = 0.0;
+
+    // Exceptions must not escape the parallel region. A thread catching one
+    // records it and every thread skips the remaining work, while still
+    // reaching every barrier. The first exception is rethrown afterwards.
+    std::exception_ptr error;
+    std::atomic<bool> failed{false};
+    const auto guarded = [&error, &failed](auto&& work) {
+      if (failed.load(std::memory_order_relaxed)) return;
+      try {
+        work();
+      } catch (...) {
+#pragma omp critical(cfd_parallel_simulator_error)
+        if (!error) error = std::current_exception();
+        failed.store(true, std::memory_order_relaxed);
+      }
+    };
+
+#pragma omp parallel num_threads(n_threads)
+    {
+      // The runtime may deliver fewer threads than requested, e.g. under
+      // OMP_THREAD_LIMIT or in nested regions, so slices are sized from the
+      // actual team.
+#pragma omp single
+      guarded([&] {
+        n_team = omp_get_num_threads();
+        thread_cpus.assign(n_team, -1);
+        busy_seconds.assign(n_team, 0.0);
+      });
+
+      const int tid = omp_get_thread_num();
+      const int cpu =
+          cpus.empty() ? -1 : cpus[tid % static_cast<int>(cpus.size())];
+      const ScopedThreadPin pin{cpu};
+      guarded([&] {
+        if (pin.pinned()) {
+          thread_cpus[tid] = cpu;
+        }
+      });
+
+      const int begin = slice_begin(nd, tid, n_team);
+      const int end = slice_begin(nd, tid + 1, n_team);
+      auto slice_params = params_;
+      slice_params.n_domain_cells = end - begin;
+      const RiemannSolver solver{slice_params};
+      const SpacialReconstructor reconstructor{slice_params};
+      const TimeIntegrator integrator{slice_params};
+
+      // First touch of the owned slice
+      guarded([&] {
+        u(seqN(nb + begin, end - begin)) = u0(seqN(begin, end - begin));
+      });
+#pragma omp barrier
+#pragma omp single
+      guarded([&] { boundary_.apply(u); });
+
+      const double start = omp_get_wtime();
+      double busy = 0.0;
+      auto view = u.segment(begin, end - begin + 2 * nb);
+      VectorXd f;
+      for (int i = 1; i <= params_.n_timesteps; ++i) {
+        guarded([&] {
+          const double flux_start = omp_get_wtime();
+          const VectorXd ul = reconstructor.calc_left(view);
+          const VectorXd ur = reconstructor.calc_right(view);
+          f = solver.calc_flux(ul, ur);
+          busy += omp_get_wtime() - flux_start;
+        });
+#pragma omp barrier
+        guarded([&] {
+          const double update_start = omp_get_wtime();
+          integrator.update(view, f);
+          busy += omp_get_wtime() - update_start;
+        });
+#pragma omp barrier
+#pragma omp single
+        guarded([&] { boundary_.apply(u); });
+      }
+      guarded([&] { busy_seconds[tid] = busy; });
+#pragma omp single
+      seconds = omp_get_wtime() - start;
+    }
+
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    if (report) {
+      this->make_report(*report, thread_cpus, busy_seconds, seconds);
+    }
+    return u(seqN(nb, nd));
+  }
+
+ private:
+  /// First domain cell of the slice owned by a thread
+  static int slice_begin(int n_domain_cells, int tid, int n_threads) noexcept {
+    return static_cast<int>(static_cast<long long>(n_domain_cells) * tid /
+                            n_threads);
+  }
+
+  void make_report(ParallelRunReport& report,
+                   const std::vector<int>& thread_cpus,
+                   const std::vector<double>& busy_seconds,
+                   double seconds) const {
+    const auto nd = params_.n_domain_cells;
+    const int n_threads = static_cast<int>(thread_cpus.size());
+    std::map<int, SocketBandwidth> sockets;
+    for (int tid = 0; tid < n_threads; ++tid) {
+      const int begin = slice_begin(nd, tid, n_threads);
+      const int end = slice_begin(nd, tid + 1, n_threads);
+      const int socket =
+          thread_cpus[tid] >= 0 ? cpu_socket(thread_cpus[tid]) : 0;
+      auto& s = sockets.try_emplace(socket, SocketBandwidth{socket, 0, 0, 0})
+                    .first->second;
+      s.n_threads += 1;
+      s.bytes += 2.0 * sizeof(double) * (end - begin) * params_.n_timesteps;
+      s.seconds = std::max(s.seconds, busy_seconds[tid]);
+    }
+    report.thread_cpus = thread_cpus;
+    report.sockets.clear();
+    for (const auto& [socket, bandwidth] : sockets) {
+      report.sockets.push_back(bandwidth);
+    }
+    report.seconds = seconds;
+  }
+
+  ProblemParameters params_;
+  ThreadingOptions options_;
+  Boundary boundary_;
+};
+
+}  // namespace cfd
+
+#endif  // CFD_PARALLEL_SCALAR_ADVECTION_EQUATION_SIMULATOR_HPP
@@ -0,0 +1,264 @@
+#ifndef CFD_PARAREAL_SIMULATOR_HPP
+#define CFD_PARAREAL_SIMULATOR_HPP
+
+#include <omp.h>
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "cfd/problem_parameters.hpp"
+#include "cfd/riemann_solvers.hpp"
+#include "cfd/scalar_advection_equation_simulator.hpp"
+#include "cfd/spacial_reconstruction_schemes.hpp"
+#include "cfd/time_integration_schemes.hpp"
+
+namespace cfd {
+
+/**
+ * @brief Options of Parareal runs
+ */
+struct PararealOptions {
+  int n_slices = 0;        ///> Number of time slices (0: OpenMP max threads)
+  int max_iterations = 2;  ///> Maximum number of iterations (0: n_slices,
+                           ///> which reproduces the fine solution serially)
+  int coarse_factor = 4;   ///> Ratio of coarse to fine time step lengths
+  double tolerance = 0.0;  ///> Absolute tolerance of the maximum change of
+                           ///> states at slice ends between iterations
+  double relative_tolerance = 0.1;  ///> Tolerance relative to the maximum
+                                    ///> difference between fine and coarse
+                                    ///> propagation in the first iteration
+};
+
+/**
+ * @brief Report of a Parareal run
+ */
+struct PararealReport {
+  int n_slices = 0;               ///> Number of time slices
+  int iterations = 0;             ///> Number of iterations
+  bool converged = false;         ///> Whether the residual is within the
+                                  ///> tolerance or all slices are exact
+  std::vector<double> residuals;  ///> Residual of each iteration
+  double coarse_fine_difference = 0.0;  ///> Maximum difference between fine
+                                        ///> and coarse propagation of a
+                                        ///> slice in the first iteration
+  double seconds = 0.0;           ///> Wall time
+  double critical_seconds = 0.0;  ///> Wall time with one thread per slice,
+                                  ///> i.e. serial coarse propagation plus the
+                                  ///> slowest fine slice of each iteration
+  double fine_seconds = 0.0;  ///> Sum of wall times of fine propagation over
+                              ///> all slices in the first iteration, i.e. the
+                              ///> time of a serial fine run
+
+  /// Speedup over a serial fine run
+  double speedup() const noexcept {
+    return seconds > 0 ? fine_seconds / seconds : 0.0;
+  }
+
+  /// Speedup over a serial fine run with one thread per slice
+  double parallel_speedup() const noexcept {
+    return critical_seconds > 0 ? fine_seconds / critical_seconds : 0.0;
+  }
+};
+
+/**
+ * @brief Parallel-in-time simulator of the scalar advection equation by the
+ * Parareal method
+ *
+ * The time steps are split into slices. In each iteration, the fine simulator
+ * advances every slice from its current initial state in parallel, and the
+ * cheap coarse simulator with a larger time step corrects the slice initial
+ * states sequentially:
+ *
+ * @f[
+ * U_{j+1}^{k+1} = G(U_j^{k+1}) + F(U_j^k) - G(U_j^k)
+ * @f]
+ *
+ * After k iterations the first k slices equal the serial fine solution, and
+ * those slices are not advanced again. n_slices iterations reproduce the fine
+ * solution, but cost more than a serial fine run, so iterations are capped
+ * well below n_slices by default. They also stop once corrections are small
+ * compared to the difference between fine and coarse propagation in the first
+ * iteration, which estimates the discretization error of the coarse
+ * simulator, since Parareal cannot make the result more accurate than that of
+ * the fine simulator anyway.
+ *
+ * @tparam FineSimulator Fine simulator, e.g. ScalarAdvectionEquationSimulator
+ * @tparam CoarseSimulator Coarse simulator. The number of boundary cells of
+ * the fine simulator is used, and the time step length is multiplied by the
+ * coarse factor, so it must stay stable at that Courant number.
+ */
+template <typename FineSimulator,
+          typename CoarseSimulator = ScalarAdvectionEquationSimulator<
+              RoeRiemannSolver, FirstOrderSpacialReconstructor,
+              ExplicitEulerScheme>>
+class PararealSimulator {
+ public:
+  /**
+   * @brief Construct a new Parareal Simulator object
+   *
+   * @param params Problem parameters of the fine simulator
+   * @param options Parareal options
+   */
+  PararealSimulator(const ProblemParameters& params,
+                    const PararealOptions& options = {})
+      : params_{params}, options_{options} {
+    assert(options.coarse_factor >= 1);
+  }
+
+  /**
+   * @brief Run simulator
+   *
+   * @tparam Derived
+   * @param u0 Initial condition
+   * @param report Report of the run, if not null
+   * @return Eigen::VectorXd Values at the end of time steps.
+   */
+  template <typename Derived>
+  Eigen::VectorXd run(const Eigen::MatrixBase<Derived>& u0,
+                      PararealReport* report = nullptr) const {
+    using Eigen::seqN;
+    using Eigen::VectorXd;
+
+    const auto nb = params_.n_boundary_cells;
+    const auto nd = params_.n_domain_cells;
+    const int n_slices = std::max(
+        1, std::min(options_.n_slices > 0 ? options_.n_slices
+                                          : omp_get_max_threads(),
+                    params_.n_timesteps));
+    const int max_iterations =
+        options_.max_iterations > 0
+            ? std::min(options_.max_iterations, n_slices)
+            : n_slices;
+
+    // Fine and coarse simulators of each slice
+    std::vector<FineSimulator> fine;
+    std::vector<CoarseSimulator> coarse;
+    std::vector<int> n_fine_steps;
+    std::vector<int> n_coarse_steps;
+    fine.reserve(n_slices);
+    coarse.reserve(n_slices);
+    for (int j = 0; j < n_slices; ++j) {
+      const int n_steps =
+          slice_begin(j + 1, n_slices) - slice_begin(j, n_slices);
+      const int m_steps =
+          (n_steps + options_.coarse_factor - 1) / options_.coarse_factor;
+      auto fine_params = params_;
+      fine_params.n_timesteps = n_steps;
+      auto coarse_params = params_;
+      coarse_params.n_timesteps = m_steps;
+      coarse_params.dt = params_.dt * n_steps / m_steps;
+      fine.emplace_back(fine_params);
+      coarse.emplace_back(coarse_params);
+      n_fine_steps.push_back(n_steps);
+      n_coarse_steps.push_back(m_steps);
+    }
+
+    const double start = omp_get_wtime();
+
+    // States at slice boundaries, and coarse propagation of each slice
+    std::vector<VectorXd> u(n_slices + 1, VectorXd(params_.n_total_cells()));
+    std::vector<VectorXd> g(n_slices + 1);
+    std::vector<VectorXd> f(n_slices + 1);
+    u[0](seqN(nb, nd)) = u0;
+    for (int j = 0; j < n_slices; ++j) {
+      g[j + 1] = u[j];
+      coarse[j].step(g[j + 1], n_coarse_steps[j]);
+      u[j + 1] = g[j + 1];
+    }
+    double critical_seconds = omp_get_wtime() - start;
+
+    std::vector<double> fine_seconds(n_slices, 0.0);
+    std::vector<double> slice_seconds(n_slices, 0.0);
+    std::vector<double> residuals;
+    double coarse_fine_difference = 0.0;
+    double tolerance = options_.tolerance;
+    int iteration = 0;
+    while (iteration < max_iterations) {
+      // Slices before the iteration number are already exact.
+#pragma omp parallel for schedule(dynamic) num_threads(n_slices)
+      for (int j = iteration; j < n_slices; ++j) {
+        const double fine_start = omp_get_wtime();
+        f[j + 1] = u[j];
+        fine[j].step(f[j + 1], n_fine_steps[j]);
+        slice_seconds[j] = omp_get_wtime() - fine_start;
+        if (iteration == 0) {
+          fine_seconds[j] = slice_seconds[j];
+        }
+      }
+      critical_seconds += *std::max_element(
+          slice_seconds.begin() + iteration, slice_seconds.end());
+      const double serial_start = omp_get_wtime();
+      ++iteration;
+
+      if (iteration == 1) {
+        for (int j = 0; j < n_slices; ++j) {
+          coarse_fine_difference =
+              std::max(coarse_fine_difference,
+                       (f[j + 1] - g[j + 1])(seqN(nb, nd))
+                           .template lpNorm<Eigen::Infinity>());
+        }
+        tolerance = std::max(
+            tolerance, options_.relative_tolerance * coarse_fine_difference);
+      }
+
+      // The first slice to correct starts from an exact state, so its fine
+      // solution is taken as is rather than corrected with round-off.
+      double residual = 0.0;
+      for (int j = iteration - 1; j < n_slices; ++j) {
+        VectorXd u_new;
+        if (j == iteration - 1) {
+          u_new = f[j + 1];
+        } else {
+          VectorXd g_new = u[j];
+          coarse[j].step(g_new, n_coarse_steps[j]);
+          u_new = g_new + f[j + 1] - g[j + 1];
+          g[j + 1] = std::move(g_new);
+        }
+        const double change = (u_new - u[j + 1])(seqN(nb, nd))
+                                  .template lpNorm<Eigen::Infinity>();
+        residual = std::max(residual, change);
+        u[j + 1] = std::move(u_new);
+      }
+      residuals.push_back(residual);
+      critical_seconds += omp_get_wtime() - serial_start;
+      if (residual <= tolerance) {
+        break;
+      }
+    }
+    const bool converged =
+        iteration >= n_slices ||
+        (!residuals.empty() && residuals.back() <= tolerance);
+
+    if (report) {
+      report->n_slices = n_slices;
+      report->iterations = iteration;
+      report->converged = converged;
+      report->residuals = residuals;
+      report->coarse_fine_difference = coarse_fine_difference;
+      report->seconds = omp_get_wtime() - start;
+      report->critical_seconds = critical_seconds;
+      report->fine_seconds = 0.0;
+      for (const auto s : fine_seconds) {
+        report->fine_seconds += s;
+      }
+    }
+    return u[n_slices](seqN(nb, nd));
+  }
+
+ private:
+  /// First time step of a slice
+  int slice_begin(int j, int n_slices) const noexcept {
+    return static_cast<int>(static_cast<long long>(params_.n_timesteps) * j /
+                            n_slices);
+  }
+
+  ProblemParameters params_;
+  PararealOptions options_;
+};
+
+}  // namespace cfd
+
+#endif  // CFD_PARAREAL_SIMULATOR_HPP
@@ -8,6 +8,16 @@
 
 namespace cfd {
 
+/**
+ * @brief Periodic boundary conditions
+ *
+ * Boundary cells are filled with copies of the domain cells at the opposite
+ * end, instead of wrapping indices around in peeled loops over the cells near
+ * the ends. The copy touches only 2 * (# of boundary cells) values per step,
+ * which is negligible next to the reconstruction of all faces, and keeping
+ * boundary cells lets every boundary condition share the same branch-free
+ * reconstruction of domain cells.
+ */
 class PeriodicBoundary {
  public:
   PeriodicBoundary(int n_boundary_cells, int n_domain_cells)
@@ -0,0 +1,54 @@
+#ifndef CFD_PROBLEM_PARAMETERS_2D_HPP
+#define CFD_PROBLEM_PARAMETERS_2D_HPP
+
+#include "cfd/problem_parameters.hpp"
+
+namespace cfd {
+
+/**
+ * @brief Parameters to solve the 2-D scalar advection equation by dimensional
+ * splitting.
+ *
+ * Domain cells are stored in a column-major (nx, ny) matrix, so that cells
+ * along the x direction are contiguous in memory. Boundary cells are not
+ * stored in the 2-D state; they are added to each 1-D line during a sweep.
+ */
+struct ProblemParameters2d {
+  int n_timesteps;       ///> Number of time steps
+  int n_domain_cells_x;  ///> Number of domain cells in the x direction
+  int n_domain_cells_y;  ///> Number of domain cells in the y direction
+  int n_boundary_cells;  ///> Number of boundary cells to add one side of a
+                         ///> 1-D line
+  double dt;             ///> Time step length
+  double dx;             ///> Cell length in the x direction
+  double dy;             ///> Cell length in the y direction
+  double velocity_x;     ///> Velocity in the x direction
+  double velocity_y;     ///> Velocity in the y direction
+  double eps;            ///> Entropy fix parameter for Harten-Riemann solver
+
+  /**
+   * @brief Returns 1-D parameters for a sweep along the x direction
+   *
+   * @param dt_sweep Time step length of the sweep
+   * @return ProblemParameters
+   */
+  ProblemParameters x_direction(double dt_sweep) const noexcept {
+    return {n_timesteps, n_domain_cells_x, n_boundary_cells, dt_sweep,
+            dx,          velocity_x,       eps};
+  }
+
+  /**
+   * @brief Returns 1-D parameters for a sweep along the y direction
+   *
+   * @param dt_sweep Time step length of the sweep
+   * @return ProblemParameters
+   */
+  ProblemParameters y_direction(double dt_sweep) const noexcept {
+    return {n_timesteps, n_domain_cells_y, n_boundary_cells, dt_sweep,
+            dy,          velocity_y,       eps};
+  }
+};
+
+}  // namespace cfd
+
+#endif  // CFD_PROBLEM_PARAMETERS_2D_HPP
\ No newline at end of file
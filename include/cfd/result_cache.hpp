@@ -0,0 +1,302 @@
+#ifndef CFD_RESULT_CACHE_HPP
+#define CFD_RESULT_CACHE_HPP
+
+#include <fmt/core.h>
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <system_error>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "cfd/binary_file_io.hpp"
+#include "cfd/problem_parameters.hpp"
+#include "cfd/version.hpp"
+
+namespace cfd {
+
+/**
+ * @brief 64-bit FNV-1a hash
+ */
+class Fnv1aHash {
+ public:
+  /// Hash bytes
+  void update(const void* data, std::size_t size) noexcept {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+      value_ = (value_ ^ bytes[i]) * 1099511628211ull;
+    }
+  }
+
+  /// Hash a string including its terminating null character
+  void update(const char* s) noexcept { this->update(s, std::strlen(s) + 1); }
+
+  /// Hash a trivially copyable value
+  template <typename T>
+  void update_value(const T& value) noexcept {
+    this->update(&value, sizeof(value));
+  }
+
+  std::uint64_t value() const noexcept { return value_; }
+
+ private:
+  std::uint64_t value_ = 14695981039346656037ull;
+};
+
+/**
+ * @brief Report of a run with a result cache
+ */
+struct ResultCacheReport {
+  bool hit = false;         ///> Whether the result was found in the cache
+  int warm_start_step = 0;  ///> Time step of the cached state started from
+  int computed_steps = 0;   ///> Number of time steps computed
+};
+
+/**
+ * @brief Persistent cache of simulation results
+ *
+ * A result is stored in a binary file named after a key and the number of
+ * time steps. The key is a hash of the library version, the type of the
+ * simulator, a scheme name given by the caller, all problem parameters except
+ * the number of time steps, and the initial condition. If no result with the
+ * requested number of time steps is cached, the cached result with the largest
+ * smaller number of time steps is advanced instead of the initial condition.
+ *
+ * Files whose total size exceeds the capacity are evicted in order of their
+ * last use, which is recorded as their modification time. Failures to store a
+ * result are reported to stderr and otherwise ignored.
+ */
+class ResultCache {
+ public:
+  /**
+   * @brief Construct a new Result Cache object
+   *
+   * @param directory Directory to store results
+   * @param capacity Maximum total size of results in bytes
+   */
+  ResultCache(const std::filesystem::path& directory,
+              std::uintmax_t capacity = std::uintmax_t{1} << 30)
+      : directory_{directory}, capacity_{capacity} {}
+
+  /**
+   * @brief Run a simulator, or reuse a cached result
+   *
+   * @tparam Simulator Simulator constructible from ProblemParameters and
+   * providing step(u, n_steps) of a state including boundary cells, e.g.
+   * ScalarAdvectionEquationSimulator
+   * @tparam Derived
+   * @param scheme Name of the run, e.g. "tvd_minmod". Results of different
+   * simulator types never share a key, even under the same name.
+   * @param params Problem parameters
+   * @param u0 Initial condition
+   * @param report Report of the run, if not null
+   * @return Eigen::VectorXd Values at the end of time steps.
+   */
+  template <typename Simulator, typename Derived>
+  Eigen::VectorXd run(const std::string& scheme,
+                      const ProblemParameters& params,
+                      const Eigen::MatrixBase<Derived>& u0,
+                      ResultCacheReport* report = nullptr) const {
+    using Eigen::seqN;
+    using Eigen::VectorXd;
+
+    const Eigen::VectorXd initial = u0;
+    const auto key = make_key<Simulator>(scheme, params, initial);
+    const auto nb = params.n_boundary_cells;
+    const auto nd = params.n_domain_cells;
+
+    ResultCacheReport r;
+    VectorXd u(params.n_total_cells());
+    u(seqN(nb, nd)) = initial;
+    for (const auto& [n, path] : this->find(key, params.n_timesteps)) {
+      const auto cached = MappedVector::map(path);
+      if (!cached.valid() || cached.size() != nd) {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        continue;
+      }
+      u(seqN(nb, nd)) = cached.values();
+      touch(path);
+      r.hit = n == params.n_timesteps;
+      r.warm_start_step = n;
+      break;
+    }
+
+    if (!r.hit) {
+      r.computed_steps = params.n_timesteps - r.warm_start_step;
+      Simulator{params}.step(u, r.computed_steps);
+      this->store(key, params.n_timesteps, u(seqN(nb, nd)));
+    }
+    if (report) {
+      *report = r;
+    }
+    return u(seqN(nb, nd));
+  }
+
+  /// Remove all results
+  void clear() const {
+    for (const auto& entry : this->entries()) {
+      std::error_code ec;
+      std::filesystem::remove(entry.path, ec);
+    }
+  }
+
+ private:
+  struct Entry {
+    std::filesystem::path path;
+    std::filesystem::file_time_type last_use;
+    std::uintmax_t size;
+  };
+
+  template <typename Simulator>
+  static std::string make_key(const std::string& scheme,
+                              const ProblemParameters& params,
+                              const Eigen::VectorXd& u0) {
+    Fnv1aHash hash;
+    hash.update(library_version());
+    hash.update(typeid(Simulator).name());
+    hash.update(scheme.c_str());
+    hash.update_value(params.n_domain_cells);
+    hash.update_value(params.n_boundary_cells);
+    hash.update_value(params.dt);
+    hash.update_value(params.dx);
+    hash.update_value(params.velocity);
+    hash.update_value(params.eps);
+    hash.update_value(u0.size());
+    hash.update(u0.data(), sizeof(double) * u0.size());
+    return fmt::format("{:016x}", hash.value());
+  }
+
+  static std::string file_name(const std::string& key, int n_timesteps) {
+    return fmt::format("{}_{}.bin", key, n_timesteps);
+  }
+
+  /// Cached results of a key with at most n_timesteps, the largest first
+  std::vector<std::pair<int, std::filesystem::path>> find(
+      const std::string& key, int n_timesteps) const {
+    std::vector<std::pair<int, std::filesystem::path>> found;
+    const auto prefix = key + "_";
+    for (const auto& entry : this->entries()) {
+      const auto stem = entry.path.stem().string();
+      if (stem.compare(0, prefix.size(), prefix) != 0) {
+        continue;
+      }
+      const auto n = std::atoi(stem.c_str() + prefix.size());
+      if (n <= n_timesteps) {
+        found.emplace_back(n, entry.path);
+      }
+    }
+    std::sort(found.begin(), found.end(),
+              [](const auto& a, const auto& b) { return a.first > b.first; });
+    return found;
+  }
+
+  /// Store a result, and evict the least recently used results over capacity
+  template <typename Derived>
+  void store(const std::string& key, int n_timesteps,
+             const Eigen::MatrixBase<Derived>& u) const {
+    namespace fs = std::filesystem;
+    const auto name = file_name(key, n_timesteps);
+    // Written to a temporary file first, so that readers never see a partial
+    // result. Its name is unique, so that processes storing the same result
+    // concurrently do not write into the same file.
+    std::random_device random;
+    const auto temporary =
+        fmt::format("{}.{:08x}{:08x}.tmp", name, random(), random());
+    std::error_code ec;
+    if (BinaryFileWriter{directory_}.try_write(u, temporary, ec)) {
+      fs::rename(directory_ / temporary, directory_ / name, ec);
+    }
+    if (ec) {
+      fmt::print(stderr, "Failed to store a result: {}\n",
+                 (directory_ / name).string());
+      fmt::print(stderr, "Error code: {}\n", ec.message());
+      std::error_code remove_ec;
+      fs::remove(directory_ / temporary, remove_ec);
+      return;
+    }
+    this->evict(directory_ / name);
+  }
+
+  void evict(const std::filesystem::path& keep) const {
+    auto entries = this->entries();
+    std::sort(entries.begin(), entries.end(),
+              [](const auto& a, const auto& b) {
+                return a.last_use < b.last_use;
+              });
+    std::uintmax_t total = 0;
+    for (const auto& entry : entries) {
+      total += entry.size;
+    }
+    for (const auto& entry : entries) {
+      if (total <= capacity_) {
+        break;
+      }
+      if (entry.path == keep) {
+        continue;
+      }
+      std::error_code ec;
+      if (std::filesystem::remove(entry.path, ec)) {
+        total -= entry.size;
+      }
+    }
+  }
+
+  std::vector<Entry> entries() const {
+    namespace fs = std::filesystem;
+    std::vector<Entry> entries;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(directory_, ec)) {
+      if (!is_result(entry.path())) {
+        continue;
+      }
+      std::error_code entry_ec;
+      const auto last_use = entry.last_write_time(entry_ec);
+      const auto size = entry.file_size(entry_ec);
+      if (!entry_ec) {
+        entries.push_back({entry.path(), last_use, size});
+      }
+    }
+    return entries;
+  }
+
+  /// Whether a file is named like a result, i.e. "<16 hex digits>_<n>.bin"
+  static bool is_result(const std::filesystem::path& path) {
+    if (path.extension() != ".bin") {
+      return false;
+    }
+    const auto stem = path.stem().string();
+    if (stem.size() < 18 || stem[16] != '_') {
+      return false;
+    }
+    for (std::size_t i = 0; i < stem.size(); ++i) {
+      const auto c = static_cast<unsigned char>(stem[i]);
+      if (i != 16 && !(i < 16 ? std::isxdigit(c) : std::isdigit(c))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Record the use of a result
+  static void touch(const std::filesystem::path& path) noexcept {
+    std::error_code ec;
+    std::filesystem::last_write_time(
+        path, std::filesystem::file_time_type::clock::now(), ec);
+  }
+
+  std::filesystem::path directory_;  ///> Directory to store results
+  std::uintmax_t capacity_;          ///> Maximum total size in bytes
+};
+
+}  // namespace cfd
+
+#endif  // CFD_RESULT_CACHE_HPP
@@ -5,6 +5,7 @@
 #include <cassert>
 
 #include "cfd/problem_parameters.hpp"
+#include "cfd/velocity_field.hpp"
 
 namespace cfd {
 
@@ -22,6 +23,37 @@ class RoeRiemannSolver {
     return 0.5 * (velocity_ * (ul + ur) - std::fabs(velocity_) * (ur - ul));
   }
 
+  /**
+   * @brief Calculate numerical flux into a given buffer
+   *
+   * @param ul Values on the left side of cell faces
+   * @param ur Values on the right side of cell faces
+   * @param flux Numerical flux
+   */
+  template <typename Derived1, typename Derived2>
+  void calc_flux(const Eigen::MatrixBase<Derived1>& ul,
+                 const Eigen::MatrixBase<Derived2>& ur,
+                 Eigen::Ref<Eigen::VectorXd> flux) const noexcept {
+    flux = 0.5 * (velocity_ * (ul + ur) - std::fabs(velocity_) * (ur - ul));
+  }
+
+  /**
+   * @brief Calculate numerical flux with velocities cached at cell faces
+   *
+   * @param ul Values on the left side of cell faces
+   * @param ur Values on the right side of cell faces
+   * @param velocity Velocity field
+   */
+  template <typename Derived1, typename Derived2>
+  Eigen::VectorXd calc_flux(const Eigen::MatrixBase<Derived1>& ul,
+                            const Eigen::MatrixBase<Derived2>& ur,
+                            const VelocityField& velocity) const noexcept {
+    assert(ul.size() == velocity.velocity().size());
+    return (0.5 * (velocity.velocity() * (ul + ur).array() -
+                   velocity.abs_velocity() * (ur - ul).array()))
+        .matrix();
+  }
+
  private:
   double velocity_;
 };
@@ -41,6 +73,39 @@ class LocalLaxFriedrichsRiemannSolver {
     return 0.5 * (velocity_ * (ul + ur) - a.cwiseProduct(ur - ul));
   }
 
+  /**
+   * @brief Calculate numerical flux into a given buffer
+   *
+   * @param ul Values on the left side of cell faces
+   * @param ur Values on the right side of cell faces
+   * @param flux Numerical flux
+   */
+  template <typename Derived1, typename Derived2>
+  void calc_flux(const Eigen::MatrixBase<Derived1>& ul,
+                 const Eigen::MatrixBase<Derived2>& ur,
+                 Eigen::Ref<Eigen::VectorXd> flux) const noexcept {
+    flux = 0.5 * (velocity_ * (ul + ur) -
+                  ul.cwiseAbs().cwiseMax(ur.cwiseAbs()).cwiseProduct(ur - ul));
+  }
+
+  /**
+   * @brief Calculate numerical flux with velocities cached at cell faces
+   *
+   * @param ul Values on the left side of cell faces
+   * @param ur Values on the right side of cell faces
+   * @param velocity Velocity field
+   */
+  template <typename Derived1, typename Derived2>
+  Eigen::VectorXd calc_flux(const Eigen::MatrixBase<Derived1>& ul,
+                            const Eigen::MatrixBase<Derived2>& ur,
+                            const VelocityField& velocity) const noexcept {
+    assert(ul.size() == velocity.velocity().size());
+    const Eigen::ArrayXd a = ul.cwiseAbs().cwiseMax(ur.cwiseAbs()).array();
+    return (0.5 * (velocity.velocity() * (ul + ur).array() -
+                   a * (ur - ul).array()))
+        .matrix();
+  }
+
  private:
   double velocity_;
 };
@@ -67,19 +132,57 @@ class HartenRiemannSolver {
   Eigen::VectorXd calc_flux(
       const Eigen::MatrixBase<Derived1>& ul,
       const Eigen::MatrixBase<Derived2>& ur) const noexcept {
-    using Eigen::VectorXd;
-    const VectorXd a = 0.5 * (ul + ur).cwiseAbs();
-    const VectorXd nu = a.unaryExpr([eps = eps_](double x) {
+    const Eigen::VectorXd nu = this->calc_nu(ul, ur);
+    return 0.5 * (velocity_ * (ul + ur) - nu.cwiseProduct(ur - ul));
+  }
+
+  /**
+   * @brief Calculate numerical flux into a given buffer
+   *
+   * @param ul Values on the left side of cell faces
+   * @param ur Values on the right side of cell faces
+   * @param flux Numerical flux
+   */
+  template <typename Derived1, typename Derived2>
+  void calc_flux(const Eigen::MatrixBase<Derived1>& ul,
+                 const Eigen::MatrixBase<Derived2>& ur,
+                 Eigen::Ref<Eigen::VectorXd> flux) const noexcept {
+    flux = 0.5 * (velocity_ * (ul + ur) -
+                  this->calc_nu(ul, ur).cwiseProduct(ur - ul));
+  }
+
+  /**
+   * @brief Calculate numerical flux with velocities cached at cell faces
+   *
+   * @param ul Values on the left side of cell faces
+   * @param ur Values on the right side of cell faces
+   * @param velocity Velocity field
+   */
+  template <typename Derived1, typename Derived2>
+  Eigen::VectorXd calc_flux(const Eigen::MatrixBase<Derived1>& ul,
+                            const Eigen::MatrixBase<Derived2>& ur,
+                            const VelocityField& velocity) const noexcept {
+    assert(ul.size() == velocity.velocity().size());
+    const Eigen::ArrayXd nu = this->calc_nu(ul, ur).array();
+    return (0.5 * (velocity.velocity() * (ul + ur).array() -
+                   nu * (ur - ul).array()))
+        .matrix();
+  }
+
+ private:
+  /// Expression of absolute characteristic speeds with the entropy fix
+  template <typename Derived1, typename Derived2>
+  auto calc_nu(const Eigen::MatrixBase<Derived1>& ul,
+               const Eigen::MatrixBase<Derived2>& ur) const noexcept {
+    return (0.5 * (ul + ur).cwiseAbs()).unaryExpr([eps = eps_](double x) {
       if (x < 2 * eps) {
         return 0.25 * x * x / eps + eps;
       } else {
         return x;
       }
     });
-    return 0.5 * (velocity_ * (ul + ur) - nu.cwiseProduct(ur - ul));
   }
 
- private:
   double velocity_;
   double eps_;
 };
@@ -2,14 +2,43 @@
 #define CFD_SCALAR_ADVECTION_EQUATION_SIMULATOR_HPP
 
 #include <Eigen/Core>
+#include <cassert>
+#include <type_traits>
+#include <utility>
 
+#include "cfd/boundary_conditions.hpp"
 #include "cfd/periodic_boundary.hpp"
 #include "cfd/problem_parameters.hpp"
+#include "cfd/state_arena.hpp"
 
 namespace cfd {
 
+/**
+ * @brief Whether a spacial reconstructor provides calc_faces(u, ul, ur), which
+ * reconstructs both sides of cell faces at once
+ */
+template <typename SpacialReconstructor, typename State, typename = void>
+struct HasCalcFaces : std::false_type {};
+
+template <typename SpacialReconstructor, typename State>
+struct HasCalcFaces<
+    SpacialReconstructor, State,
+    std::void_t<decltype(std::declval<const SpacialReconstructor&>().calc_faces(
+        std::declval<const State&>(), std::declval<Eigen::VectorXd&>(),
+        std::declval<Eigen::VectorXd&>()))>> : std::true_type {};
+
+/**
+ * @brief Simulator of the scalar advection equation
+ *
+ * @tparam RiemannSolver Riemann solver
+ * @tparam SpacialReconstructor Spacial reconstructor
+ * @tparam TimeIntegrator Time integrator
+ * @tparam Boundary Boundary conditions, e.g. PeriodicBoundary,
+ * DirichletBoundary, OutflowBoundary, ReflectiveBoundary, or
+ * InflowOutflowBoundary
+ */
 template <typename RiemannSolver, typename SpacialReconstructor,
-          typename TimeIntegrator>
+          typename TimeIntegrator, typename Boundary = PeriodicBoundary>
 class ScalarAdvectionEquationSimulator {
  public:
   /**
@@ -27,6 +56,22 @@ class ScalarAdvectionEquationSimulator {
         integrator_{params},
         boundary_{params} {}
 
+  /**
+   * @brief Construct a new Scalar Advection Equation Simulator object
+   *
+   * @param params Problem parameters
+   * @param boundary Boundary conditions
+   */
+  ScalarAdvectionEquationSimulator(const ProblemParameters& params,
+                                   const Boundary& boundary)
+      : n_boundary_cells_{params.n_boundary_cells},
+        n_domain_cells_{params.n_domain_cells},
+        n_timesteps_{params.n_timesteps},
+        solver_{params},
+        reconstructor_{params},
+        integrator_{params},
+        boundary_{boundary} {}
+
   /**
    * @brief Run simulator
    *
@@ -41,31 +86,131 @@ class ScalarAdvectionEquationSimulator {
 
     VectorXd u(this->n_total_cells());
     u(seqN(n_boundary_cells_, n_domain_cells_)) = u0;
-    boundary_.apply(u);
+    this->step(u, n_timesteps_);
 
-    for (int i = 1; i <= n_timesteps_; ++i) {
-      const VectorXd ul = reconstructor_.calc_left(u);
-      const VectorXd ur = reconstructor_.calc_right(u);
-      const VectorXd f = solver_.calc_flux(ul, ur);
-      integrator_.update(u, f);
-      boundary_.apply(u);
-    }
+    return u(seqN(n_boundary_cells_, n_domain_cells_));
+  }
+
+  /**
+   * @brief Run simulator with the state and scratch buffers placed in an arena
+   *
+   * The arena is reset, so that its memory is reused by successive runs, e.g.
+   * of ensemble members. Face values, numerical flux, and scratch buffers of
+   * the reconstructor and the time integrator are allocated from the arena
+   * and freed at the end of each time step, so that no time step allocates on
+   * the heap.
+   *
+   * @tparam Derived
+   * @param u0 Initial condition
+   * @param arena Arena to place the state including boundary cells
+   * @return Eigen::VectorXd Values at the end of time steps.
+   */
+  template <typename Derived>
+  Eigen::VectorXd run(const Eigen::MatrixBase<Derived>& u0,
+                      StateArena& arena) const {
+    using Eigen::seqN;
+
+    // The state, stage buffers of the time integrator, face values on both
+    // sides, and scratch buffers of the reconstructor
+    constexpr int n_buffers = 1 + TimeIntegrator::n_arena_buffers + 2 +
+                              SpacialReconstructor::n_arena_buffers;
+    arena.reset();
+    arena.reserve(Eigen::Index{n_buffers} * this->n_total_cells(), n_buffers);
+    auto u = arena.allocate(this->n_total_cells());
+    u(seqN(n_boundary_cells_, n_domain_cells_)) = u0;
+    this->step(u, n_timesteps_, arena);
 
     return u(seqN(n_boundary_cells_, n_domain_cells_));
   }
 
- private:
+  /**
+   * @brief Advance a state including boundary cells in place
+   *
+   * Boundary cells are overwritten, so only domain cells need to be set.
+   *
+   * @tparam Derived
+   * @param u State of size (# of total cells)
+   * @param n_steps Number of time steps
+   */
+  template <typename Derived>
+  void step(Eigen::MatrixBase<Derived>& u, int n_steps) const noexcept {
+    assert(u.size() == this->n_total_cells());
+    using Eigen::VectorXd;
+
+    const auto calc_flux = [this](const auto& v) {
+      using State = std::decay_t<decltype(v)>;
+      if constexpr (HasCalcFaces<SpacialReconstructor, State>::value) {
+        VectorXd ul, ur;
+        reconstructor_.calc_faces(v, ul, ur);
+        return solver_.calc_flux(ul, ur);
+      } else {
+        const VectorXd ul = reconstructor_.calc_left(v);
+        const VectorXd ur = reconstructor_.calc_right(v);
+        return solver_.calc_flux(ul, ur);
+      }
+    };
+    const auto apply_boundary = [this](auto& v) { boundary_.apply(v); };
+
+    boundary_.apply(u);
+    for (int i = 1; i <= n_steps; ++i) {
+      integrator_.advance(u, calc_flux, apply_boundary);
+    }
+  }
+
+  /**
+   * @brief Advance a state including boundary cells in place with scratch
+   * buffers in an arena
+   *
+   * The arena must have room for the buffers of a time step, which are freed
+   * at its end.
+   *
+   * @tparam Derived
+   * @param u State of size (# of total cells)
+   * @param n_steps Number of time steps
+   * @param arena Arena to allocate scratch buffers
+   */
+  template <typename Derived>
+  void step(Eigen::MatrixBase<Derived>& u, int n_steps,
+            StateArena& arena) const {
+    assert(u.size() == this->n_total_cells());
+
+    const auto calc_flux = [this, &arena](const auto& v, auto& flux) {
+      using State = std::decay_t<decltype(v)>;
+      StateArena::Scope scope{arena};
+      auto ul = arena.allocate(n_domain_cells_ + 1);
+      auto ur = arena.allocate(n_domain_cells_ + 1);
+      if constexpr (HasCalcFaces<SpacialReconstructor, State>::value) {
+        reconstructor_.calc_faces(v, ul, ur, arena);
+      } else {
+        reconstructor_.calc_left(v, ul, arena);
+        reconstructor_.calc_right(v, ur, arena);
+      }
+      solver_.calc_flux(ul, ur, flux);
+    };
+    const auto apply_boundary = [this](auto& v) { boundary_.apply(v); };
+
+    boundary_.apply(u);
+    for (int i = 1; i <= n_steps; ++i) {
+      integrator_.advance(u, calc_flux, apply_boundary, arena);
+    }
+  }
+
   int n_total_cells() const noexcept {
     return n_boundary_cells_ * 2 + n_domain_cells_;
   }
 
+  const SpacialReconstructor& reconstructor() const noexcept {
+    return reconstructor_;
+  }
+
+ private:
   int n_boundary_cells_;
   int n_domain_cells_;
   int n_timesteps_;
   RiemannSolver solver_;
   SpacialReconstructor reconstructor_;
   TimeIntegrator integrator_;
-  PeriodicBoundary boundary_;
+  Boundary boundary_;
 };
 
 }  // namespace cfd
@@ -0,0 +1,235 @@
+#ifndef CFD_SCALAR_ADVECTION_EQUATION_SIMULATOR_2D_HPP
+#define CFD_SCALAR_ADVECTION_EQUATION_SIMULATOR_2D_HPP
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+
+#include "cfd/periodic_boundary.hpp"
+#include "cfd/problem_parameters.hpp"
+#include "cfd/problem_parameters_2d.hpp"
+#include "cfd/scalar_advection_equation_simulator.hpp"
+
+namespace cfd {
+
+/**
+ * @brief Transpose a matrix tile by tile
+ *
+ * Each tile of the source is read and written while it stays in cache, so
+ * that neither the reads nor the writes walk the whole matrix with a large
+ * stride. Tiles are distributed among OpenMP threads.
+ *
+ * @param src Source matrix
+ * @param dst Destination matrix of size (src.cols(), src.rows())
+ * @param tile_size Number of rows and columns of a tile
+ */
+inline void transpose_blocked(const Eigen::MatrixXd& src, Eigen::MatrixXd& dst,
+                              int tile_size) noexcept {
+  assert(dst.rows() == src.cols() && dst.cols() == src.rows());
+  assert(tile_size > 0);
+  const int n_rows = static_cast<int>(src.rows());
+  const int n_cols = static_cast<int>(src.cols());
+#pragma omp parallel for schedule(static)
+  for (int j = 0; j < n_cols; j += tile_size) {
+    const int nc = std::min(tile_size, n_cols - j);
+    for (int i = 0; i < n_rows; i += tile_size) {
+      const int nr = std::min(tile_size, n_rows - i);
+      dst.block(j, i, nc, nr) = src.block(i, j, nr, nc).transpose();
+    }
+  }
+}
+
+/**
+ * @brief Advance every column of a matrix by one time step of a 1-D scheme
+ *
+ * Each column is a 1-D line of domain cells. It is copied into a line buffer
+ * with boundary cells, advanced with the 1-D Riemann solver, spacial
+ * reconstructor and time integrator, and copied back. Columns are distributed
+ * among OpenMP threads, and each thread owns its line buffer.
+ *
+ * @tparam RiemannSolver Riemann solver
+ * @tparam SpacialReconstructor Spacial reconstructor
+ * @tparam TimeIntegrator Time integrator providing
+ * advance(u, calc_flux, apply_boundary)
+ * @tparam Boundary Boundary conditions of a line
+ */
+template <typename RiemannSolver, typename SpacialReconstructor,
+          typename TimeIntegrator, typename Boundary = PeriodicBoundary>
+class LineSweeper {
+ public:
+  /**
+   * @brief Construct a new Line Sweeper object
+   *
+   * @param params 1-D parameters of a line
+   */
+  LineSweeper(const ProblemParameters& params)
+      : n_boundary_cells_{params.n_boundary_cells},
+        n_domain_cells_{params.n_domain_cells},
+        solver_{params},
+        reconstructor_{params},
+        integrator_{params},
+        boundary_{params} {}
+
+  /**
+   * @brief Construct a new Line Sweeper object
+   *
+   * @param params 1-D parameters of a line
+   * @param boundary Boundary conditions of a line
+   */
+  LineSweeper(const ProblemParameters& params, const Boundary& boundary)
+      : n_boundary_cells_{params.n_boundary_cells},
+        n_domain_cells_{params.n_domain_cells},
+        solver_{params},
+        reconstructor_{params},
+        integrator_{params},
+        boundary_{boundary} {}
+
+  /**
+   * @brief Advance all columns of @f$ u @f$ by one time step
+   *
+   * @param u Domain cells, one line per column
+   */
+  void operator()(Eigen::MatrixXd& u) const noexcept {
+    assert(u.rows() == n_domain_cells_);
+    using Eigen::seqN;
+    using Eigen::VectorXd;
+    const int n_lines = static_cast<int>(u.cols());
+    const auto calc_flux = [this](const auto& v) {
+      using State = std::decay_t<decltype(v)>;
+      if constexpr (HasCalcFaces<SpacialReconstructor, State>::value) {
+        VectorXd ul, ur;
+        reconstructor_.calc_faces(v, ul, ur);
+        return solver_.calc_flux(ul, ur);
+      } else {
+        const VectorXd ul = reconstructor_.calc_left(v);
+        const VectorXd ur = reconstructor_.calc_right(v);
+        return solver_.calc_flux(ul, ur);
+      }
+    };
+    const auto apply_boundary = [this](auto& v) { boundary_.apply(v); };
+#pragma omp parallel
+    {
+      VectorXd line(n_boundary_cells_ * 2 + n_domain_cells_);
+#pragma omp for schedule(static)
+      for (int j = 0; j < n_lines; ++j) {
+        line(seqN(n_boundary_cells_, n_domain_cells_)) = u.col(j);
+        boundary_.apply(line);
+        integrator_.advance(line, calc_flux, apply_boundary);
+        u.col(j) = line(seqN(n_boundary_cells_, n_domain_cells_));
+      }
+    }
+  }
+
+ private:
+  int n_boundary_cells_;
+  int n_domain_cells_;
+  RiemannSolver solver_;
+  SpacialReconstructor reconstructor_;
+  TimeIntegrator integrator_;
+  Boundary boundary_;
+};
+
+/**
+ * @brief 2-D scalar advection equation simulator using Strang splitting
+ *
+ * One time step is composed of 1-D sweeps as
+ * @f[
+ * u^{n+1} = X(\Delta t / 2) \, Y(\Delta t) \, X(\Delta t / 2) \, u^n
+ * @f]
+ * where @f$ X @f$ and @f$ Y @f$ are 1-D schemes in the x and y directions.
+ * The state is kept as a column-major (nx, ny) matrix, so x-sweeps are unit
+ * stride. Before a y-sweep, the state is transposed tile by tile into a
+ * (ny, nx) matrix, so y-sweeps are also unit stride.
+ *
+ * Each sweep advances lines by a full step of the time integrator, e.g.
+ * SspRungeKutta3Scheme for a high-order scheme in time, so that the splitting
+ * error is of second order.
+ *
+ * @tparam RiemannSolver Riemann solver
+ * @tparam SpacialReconstructor Spacial reconstructor
+ * @tparam TimeIntegrator Time integrator providing
+ * advance(u, calc_flux, apply_boundary)
+ * @tparam Boundary Boundary conditions of x and y lines, e.g. PeriodicBoundary,
+ * DirichletBoundary, OutflowBoundary, ReflectiveBoundary, or
+ * InflowOutflowBoundary
+ */
+template <typename RiemannSolver, typename SpacialReconstructor,
+          typename TimeIntegrator, typename Boundary = PeriodicBoundary>
+class ScalarAdvectionEquationSimulator2d {
+ public:
+  /**
+   * @brief Construct a new 2-D Scalar Advection Equation Simulator object
+   *
+   * @param params Problem parameters
+   * @param tile_size Number of rows and columns of a tile in transposes
+   */
+  ScalarAdvectionEquationSimulator2d(const ProblemParameters2d& params,
+                                     int tile_size = 32)
+      : n_domain_cells_x_{params.n_domain_cells_x},
+        n_domain_cells_y_{params.n_domain_cells_y},
+        n_timesteps_{params.n_timesteps},
+        tile_size_{tile_size},
+        x_sweeper_{params.x_direction(0.5 * params.dt)},
+        y_sweeper_{params.y_direction(params.dt)} {}
+
+  /**
+   * @brief Construct a new 2-D Scalar Advection Equation Simulator object
+   *
+   * @param params Problem parameters
+   * @param x_boundary Boundary conditions of x lines
+   * @param y_boundary Boundary conditions of y lines
+   * @param tile_size Number of rows and columns of a tile in transposes
+   */
+  ScalarAdvectionEquationSimulator2d(const ProblemParameters2d& params,
+                                     const Boundary& x_boundary,
+                                     const Boundary& y_boundary,
+                                     int tile_size = 32)
+      : n_domain_cells_x_{params.n_domain_cells_x},
+        n_domain_cells_y_{params.n_domain_cells_y},
+        n_timesteps_{params.n_timesteps},
+        tile_size_{tile_size},
+        x_sweeper_{params.x_direction(0.5 * params.dt), x_boundary},
+        y_sweeper_{params.y_direction(params.dt), y_boundary} {}
+
+  /**
+   * @brief Run simulator
+   *
+   * @tparam Derived
+   * @param u0 Initial condition of size (nx, ny)
+   * @return Eigen::MatrixXd Values at the end of time steps.
+   */
+  template <typename Derived>
+  Eigen::MatrixXd run(const Eigen::MatrixBase<Derived>& u0) const noexcept {
+    assert(u0.rows() == n_domain_cells_x_ && u0.cols() == n_domain_cells_y_);
+    using Eigen::MatrixXd;
+
+    MatrixXd u = u0;
+    MatrixXd ut(n_domain_cells_y_, n_domain_cells_x_);
+
+    for (int i = 1; i <= n_timesteps_; ++i) {
+      x_sweeper_(u);
+      transpose_blocked(u, ut, tile_size_);
+      y_sweeper_(ut);
+      transpose_blocked(ut, u, tile_size_);
+      x_sweeper_(u);
+    }
+
+    return u;
+  }
+
+ private:
+  using Sweeper = LineSweeper<RiemannSolver, SpacialReconstructor,
+                              TimeIntegrator, Boundary>;
+
+  int n_domain_cells_x_;
+  int n_domain_cells_y_;
+  int n_timesteps_;
+  int tile_size_;
+  Sweeper x_sweeper_;
+  Sweeper y_sweeper_;
+};
+
+}  // namespace cfd
+
+#endif  // CFD_SCALAR_ADVECTION_EQUATION_SIMULATOR_2D_HPP
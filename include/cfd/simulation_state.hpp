@@ -0,0 +1,205 @@
+#ifndef CFD_SIMULATION_STATE_HPP
+#define CFD_SIMULATION_STATE_HPP
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+
+#include "cfd/problem_parameters.hpp"
+#include "cfd/time_step_split.hpp"
+
+namespace cfd {
+
+/**
+ * @brief Resumable state of a simulation
+ *
+ * The state is advanced on demand by step() or advance_to(), and frames can be
+ * pulled lazily from frames(), so that consumers can inspect the state at
+ * their own pace and stop early without computing the remaining time steps.
+ *
+ * @tparam Simulator Simulator constructible from ProblemParameters and
+ * providing step(u, n_steps) of a state including boundary cells, e.g.
+ * ScalarAdvectionEquationSimulator
+ */
+template <typename Simulator>
+class SimulationState {
+ public:
+  using ConstView = Eigen::Map<const Eigen::VectorXd>;
+
+  /**
+   * @brief Frame of a simulation
+   *
+   * The values refer to the state, so they are valid until it is advanced.
+   */
+  struct Frame {
+    int step;          ///> Number of time steps taken
+    double time;       ///> Time
+    ConstView values;  ///> Values in domain cells
+  };
+
+  class FrameRange;
+
+  /**
+   * @brief Construct a new Simulation State object
+   *
+   * @tparam Derived
+   * @param params Problem parameters. n_timesteps is the number of time steps
+   * up to which frames() yields frames.
+   * @param u0 Initial condition
+   */
+  template <typename Derived>
+  SimulationState(const ProblemParameters& params,
+                  const Eigen::MatrixBase<Derived>& u0)
+      : params_{params},
+        simulator_{params},
+        u_(params.n_total_cells()) {
+    u_.segment(params.n_boundary_cells, params.n_domain_cells) = u0;
+    // Applies boundary conditions only
+    simulator_.step(u_, 0);
+  }
+
+  /**
+   * @brief Advance the state by time steps
+   *
+   * @param n_steps Number of time steps
+   */
+  void step(int n_steps = 1) noexcept {
+    assert(n_steps >= 0);
+    simulator_.step(u_, n_steps);
+    step_ += n_steps;
+    time_ += n_steps * params_.dt;
+  }
+
+  /**
+   * @brief Advance the state up to a time
+   *
+   * The last time step is shortened to land exactly on the time.
+   *
+   * @param t_end Time
+   * @return bool Whether the state was advanced. It is not if the time is
+   * earlier than the current time or the number of time steps does not fit in
+   * int.
+   */
+  bool advance_to(double t_end) {
+    const auto split = split_time_steps(time_, t_end, params_.dt);
+    // Checked before adding the shortened step, which would overflow when
+    // the full time steps alone reach the limit
+    if (!split || split->n_steps > std::numeric_limits<int>::max() - step_ -
+                                       (split->remainder > 0)) {
+      return false;
+    }
+    const double t_start = time_;
+    this->step(split->n_steps);
+    if (split->remainder > 0) {
+      auto params = params_;
+      params.dt = split->remainder;
+      Simulator{params}.step(u_, 1);
+      step_ += 1;
+    }
+    time_ = std::max(t_end, t_start);
+    return true;
+  }
+
+  /**
+   * @brief Lazy range of frames
+   *
+   * The first frame is the current state, and each following frame is
+   * computed only when the range is advanced to it, by stride time steps or
+   * fewer for the last frame at n_timesteps. Frames are views of the state,
+   * which is never copied.
+   *
+   * @param stride Number of time steps between frames
+   * @return FrameRange Range of frames
+   */
+  FrameRange frames(int stride = 1) noexcept {
+    assert(stride >= 1);
+    return FrameRange{*this, stride};
+  }
+
+  /// Number of time steps taken
+  int step_count() const noexcept { return step_; }
+
+  /// Time
+  double time() const noexcept { return time_; }
+
+  /// Values in domain cells
+  ConstView values() const noexcept {
+    return ConstView(u_.data() + params_.n_boundary_cells,
+                     params_.n_domain_cells);
+  }
+
+  /// Current frame
+  Frame frame() const noexcept { return {step_, time_, this->values()}; }
+
+  /// State including boundary cells
+  const Eigen::VectorXd& state() const noexcept { return u_; }
+
+ private:
+  ProblemParameters params_;
+  Simulator simulator_;
+  Eigen::VectorXd u_;  ///> State including boundary cells
+  int step_ = 0;       ///> Number of time steps taken
+  double time_ = 0.0;  ///> Time
+};
+
+/**
+ * @brief Input range of frames, which advances the state when incremented
+ */
+template <typename Simulator>
+class SimulationState<Simulator>::FrameRange {
+ public:
+  struct Sentinel {};
+
+  class Iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Frame;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Frame*;
+    using reference = Frame;
+
+    Iterator(SimulationState& state, int stride) noexcept
+        : state_{&state}, stride_{stride} {}
+
+    Frame operator*() const noexcept { return state_->frame(); }
+
+    Iterator& operator++() noexcept {
+      const int n = std::min(stride_, this->remaining());
+      if (n > 0) {
+        state_->step(n);
+      } else {
+        done_ = true;
+      }
+      return *this;
+    }
+
+    bool operator==(Sentinel) const noexcept { return done_; }
+    bool operator!=(Sentinel) const noexcept { return !done_; }
+
+   private:
+    int remaining() const noexcept {
+      return state_->params_.n_timesteps - state_->step_;
+    }
+
+    SimulationState* state_;
+    int stride_;
+    bool done_ = false;
+  };
+
+  FrameRange(SimulationState& state, int stride) noexcept
+      : state_{state}, stride_{stride} {}
+
+  Iterator begin() const noexcept { return Iterator{state_, stride_}; }
+  Sentinel end() const noexcept { return {}; }
+
+ private:
+  SimulationState& state_;
+  int stride_;
+};
+
+}  // namespace cfd
+
+#endif  // CFD_SIMULATION_STATE_HPP
@@ -5,6 +5,9 @@
 
 namespace cfd {
 
+// Each limiter evaluates @f$ \Phi (r) @f$ either into a new vector or into a
+// given buffer, which may be r itself.
+
 /**
  * @brief Minmod limiter
  *
@@ -17,6 +20,12 @@ struct MinmodLimiter {
   static Eigen::VectorXd eval(const Eigen::MatrixBase<Derived>& r) noexcept {
     return r.cwiseMin(1).cwiseMax(0);
   }
+
+  template <typename Derived>
+  static void eval(const Eigen::MatrixBase<Derived>& r,
+                   Eigen::Ref<Eigen::VectorXd> phi) noexcept {
+    phi = r.cwiseMin(1).cwiseMax(0);
+  }
 };
 
 /**
@@ -31,6 +40,12 @@ struct SuperbeeLimiter {
   static Eigen::VectorXd eval(const Eigen::MatrixBase<Derived>& r) noexcept {
     return (2 * r).cwiseMin(1).cwiseMax(r.cwiseMin(2)).cwiseMax(0);
   }
+
+  template <typename Derived>
+  static void eval(const Eigen::MatrixBase<Derived>& r,
+                   Eigen::Ref<Eigen::VectorXd> phi) noexcept {
+    phi = (2 * r).cwiseMin(1).cwiseMax(r.cwiseMin(2)).cwiseMax(0);
+  }
 };
 
 /**
@@ -45,6 +60,12 @@ struct VanLeerLimiter {
   static Eigen::VectorXd eval(const Eigen::MatrixBase<Derived>& r) noexcept {
     return ((r.array() + r.array().abs()) / (1 + r.array().abs())).matrix();
   }
+
+  template <typename Derived>
+  static void eval(const Eigen::MatrixBase<Derived>& r,
+                   Eigen::Ref<Eigen::VectorXd> phi) noexcept {
+    phi = ((r.array() + r.array().abs()) / (1 + r.array().abs())).matrix();
+  }
 };
 
 /**
@@ -60,6 +81,13 @@ struct VanAlbadaLimiter {
     const Eigen::VectorXd r2 = r.array().square().matrix();
     return ((r.array() + r2.array()) / (1 + r2.array())).matrix();
   }
+
+  template <typename Derived>
+  static void eval(const Eigen::MatrixBase<Derived>& r,
+                   Eigen::Ref<Eigen::VectorXd> phi) noexcept {
+    phi = ((r.array() + r.array().square()) / (1 + r.array().square()))
+              .matrix();
+  }
 };
 
 }  // namespace cfd
@@ -2,14 +2,24 @@
 #define CFD_SPACIAL_RECONSTRUCTION_SCHEMES_HPP
 
 #include <Eigen/Core>
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <vector>
 
 #include "cfd/problem_parameters.hpp"
+#include "cfd/state_arena.hpp"
+#include "cfd/velocity_field.hpp"
 
 namespace cfd {
 
 class FirstOrderSpacialReconstructor {
  public:
+  /// Number of scratch buffers of at most (# of total cells) doubles, which
+  /// the overloads with an arena allocate at once
+  static constexpr int n_arena_buffers = 0;
+
   FirstOrderSpacialReconstructor(const ProblemParameters& params)
       : n_boundary_cells_{params.n_boundary_cells},
         n_domain_cells_{params.n_domain_cells} {
@@ -39,6 +49,32 @@ class FirstOrderSpacialReconstructor {
     return u(Eigen::seqN(n_boundary_cells_, n_domain_cells_ + 1));
   }
 
+  template <typename Derived>
+  Eigen::VectorXd calc_left(const Eigen::MatrixBase<Derived>& u,
+                            const VelocityField&) const noexcept {
+    return this->calc_left(u);
+  }
+
+  template <typename Derived>
+  Eigen::VectorXd calc_right(const Eigen::MatrixBase<Derived>& u,
+                             const VelocityField&) const noexcept {
+    return this->calc_right(u);
+  }
+
+  template <typename Derived>
+  void calc_left(const Eigen::MatrixBase<Derived>& u,
+                 Eigen::Ref<Eigen::VectorXd> ul, StateArena&) const noexcept {
+    assert(u.size() == (n_boundary_cells_ * 2 + n_domain_cells_));
+    ul = u(Eigen::seqN(n_boundary_cells_ - 1, n_domain_cells_ + 1));
+  }
+
+  template <typename Derived>
+  void calc_right(const Eigen::MatrixBase<Derived>& u,
+                  Eigen::Ref<Eigen::VectorXd> ur, StateArena&) const noexcept {
+    assert(u.size() == (n_boundary_cells_ * 2 + n_domain_cells_));
+    ur = u(Eigen::seqN(n_boundary_cells_, n_domain_cells_ + 1));
+  }
+
  private:
   int n_boundary_cells_;
   int n_domain_cells_;
@@ -46,6 +82,10 @@ class FirstOrderSpacialReconstructor {
 
 class BeamWarmingSpacialReconstructor {
  public:
+  /// Number of scratch buffers of at most (# of total cells) doubles, which
+  /// the overloads with an arena allocate at once
+  static constexpr int n_arena_buffers = 0;
+
   BeamWarmingSpacialReconstructor(const ProblemParameters& params)
       : n_boundary_cells_{params.n_boundary_cells},
         n_domain_cells_{params.n_domain_cells},
@@ -59,26 +99,66 @@ class BeamWarmingSpacialReconstructor {
   template <typename Derived>
   Eigen::VectorXd calc_left(
       const Eigen::MatrixBase<Derived>& u) const noexcept {
-    assert(u.size() == (n_boundary_cells_ * 2 + n_domain_cells_));
-    const Eigen::VectorXd delta =
-        0.5 * (u.segment(n_boundary_cells_ - 1, n_domain_cells_ + 1) -
-               u.segment(n_boundary_cells_ - 2, n_domain_cells_ + 1));
-    return u.segment(n_boundary_cells_ - 1, n_domain_cells_ + 1) +
-           (1 - velocity_ * dt_ / dx_) * delta;
+    return this->calc_left_impl(u, velocity_ * dt_ / dx_);
   }
 
   template <typename Derived>
   Eigen::VectorXd calc_right(
       const Eigen::MatrixBase<Derived>& u) const noexcept {
-    assert(u.size() == (n_boundary_cells_ * 2 + n_domain_cells_));
-    const Eigen::VectorXd delta =
-        0.5 * (u.segment(n_boundary_cells_ + 1, n_domain_cells_ + 1) -
-               u.segment(n_boundary_cells_, n_domain_cells_ + 1));
-    return u.segment(n_boundary_cells_, n_domain_cells_ + 1) -
-           (1 + velocity_ * dt_ / dx_) * delta;
+    return this->calc_right_impl(u, velocity_ * dt_ / dx_);
+  }
+
+  template <typename Derived>
+  Eigen::VectorXd calc_left(const Eigen::MatrixBase<Derived>& u,
+                            const VelocityField& velocity) const noexcept {
+    return this->calc_left_impl(u, velocity.courant());
+  }
+
+  template <typename Derived>
+  Eigen::VectorXd calc_right(const Eigen::MatrixBase<Derived>& u,
+                             const VelocityField& velocity) const noexcept {
+    return this->calc_right_impl(u, velocity.courant());
+  }
+
+  template <typename Derived>
+  void calc_left(const Eigen::MatrixBase<Derived>& u,
+                 Eigen::Ref<Eigen::VectorXd> ul, StateArena&) const noexcept {
+    ul = this->calc_left_impl(u, velocity_ * dt_ / dx_);
+  }
+
+  template <typename Derived>
+  void calc_right(const Eigen::MatrixBase<Derived>& u,
+                  Eigen::Ref<Eigen::VectorXd> ur, StateArena&) const noexcept {
+    ur = this->calc_right_impl(u, velocity_ * dt_ / dx_);
   }
 
  private:
+  /// Expression of values at faces, to be evaluated into the destination
+  template <typename Derived, typename Courant>
+  auto calc_left_impl(const Eigen::MatrixBase<Derived>& u,
+                      const Courant& courant) const noexcept {
+    const auto nb = n_boundary_cells_;
+    const auto nd = n_domain_cells_;
+    assert(u.size() == (nb * 2 + nd));
+    const auto delta =
+        0.5 * (u.segment(nb - 1, nd + 1) - u.segment(nb - 2, nd + 1));
+    return (u.segment(nb - 1, nd + 1).array() + (1 - courant) * delta.array())
+        .matrix();
+  }
+
+  /// Expression of values at faces, to be evaluated into the destination
+  template <typename Derived, typename Courant>
+  auto calc_right_impl(const Eigen::MatrixBase<Derived>& u,
+                       const Courant& courant) const noexcept {
+    const auto nb = n_boundary_cells_;
+    const auto nd = n_domain_cells_;
+    assert(u.size() == (nb * 2 + nd));
+    const auto delta =
+        0.5 * (u.segment(nb + 1, nd + 1) - u.segment(nb, nd + 1));
+    return (u.segment(nb, nd + 1).array() - (1 + courant) * delta.array())
+        .matrix();
+  }
+
   int n_boundary_cells_;
   int n_domain_cells_;
   double dt_;
@@ -88,6 +168,10 @@ class BeamWarmingSpacialReconstructor {
 
 class FrommSpacialReconstructor {
  public:
+  /// Number of scratch buffers of at most (# of total cells) doubles, which
+  /// the overloads with an arena allocate at once
+  static constexpr int n_arena_buffers = 0;
+
   FrommSpacialReconstructor(const ProblemParameters& params)
       : n_boundary_cells_{params.n_boundary_cells},
         n_domain_cells_{params.n_domain_cells},
@@ -101,26 +185,66 @@ class FrommSpacialReconstructor {
   template <typename Derived>
   Eigen::VectorXd calc_left(
       const Eigen::MatrixBase<Derived>& u) const noexcept {
-    assert(u.size() == (n_boundary_cells_ * 2 + n_domain_cells_));
-    const Eigen::VectorXd delta =
-        0.25 * (u.segment(n_boundary_cells_, n_domain_cells_ + 1) -
-                u.segment(n_boundary_cells_ - 2, n_domain_cells_ + 1));
-    return u.segment(n_boundary_cells_ - 1, n_domain_cells_ + 1) +
-           (1 - velocity_ * dt_ / dx_) * delta;
+    return this->calc_left_impl(u, velocity_ * dt_ / dx_);
   }
 
   template <typename Derived>
   Eigen::VectorXd calc_right(
       const Eigen::MatrixBase<Derived>& u) const noexcept {
-    assert(u.size() == (n_boundary_cells_ * 2 + n_domain_cells_));
-    const Eigen::VectorXd delta =
-        0.25 * (u.segment(n_boundary_cells_ + 1, n_domain_cells_ + 1) -
-                u.segment(n_boundary_cells_ - 1, n_domain_cells_ + 1));
-    return u.segment(n_boundary_cells_, n_domain_cells_ + 1) -
-           (1 + velocity_ * dt_ / dx_) * delta;
+    return this->calc_right_impl(u, velocity_ * dt_ / dx_);
+  }
+
+  template <typename Derived>
+  Eigen::VectorXd calc_left(const Eigen::MatrixBase<Derived>& u,
+                            const VelocityField& velocity) const noexcept {
+    return this->calc_left_impl(u, velocity.courant());
+  }
+
+  template <typename Derived>
+  Eigen::VectorXd calc_right(const Eigen::MatrixBase<Derived>& u,
+                             const VelocityField& velocity) const noexcept {
+    return this->calc_right_impl(u, velocity.courant());
+  }
+
+  template <typename Derived>
+  void calc_left(const Eigen::MatrixBase<Derived>& u,
+                 Eigen::Ref<Eigen::VectorXd> ul, StateArena&) const noexcept {
+    ul = this->calc_left_impl(u, velocity_ * dt_ / dx_);
+  }
+
+  template <typename Derived>
+  void calc_right(const Eigen::MatrixBase<Derived>& u,
+                  Eigen::Ref<Eigen::VectorXd> ur, StateArena&) const noexcept {
+    ur = this->calc_right_impl(u, velocity_ * dt_ / dx_);
   }
 
  private:
+  /// Expression of values at faces, to be evaluated into the destination
+  template <typename Derived, typename Courant>
+  auto calc_left_impl(const Eigen::MatrixBase<Derived>& u,
+                      const Courant& courant) const noexcept {
+    const auto nb = n_boundary_cells_;
+    const auto nd = n_domain_cells_;
+    assert(u.size() == (nb * 2 + nd));
+    const auto delta =
+        0.25 * (u.segment(nb, nd + 1) - u.segment(nb - 2, nd + 1));
+    return (u.segment(nb - 1, nd + 1).array() + (1 - courant) * delta.array())
+        .matrix();
+  }
+
+  /// Expression of values at faces, to be evaluated into the destination
+  template <typename Derived, typename Courant>
+  auto calc_right_impl(const Eigen::MatrixBase<Derived>& u,
+                       const Courant& courant) const noexcept {
+    const auto nb = n_boundary_cells_;
+    const auto nd = n_domain_cells_;
+    assert(u.size() == (nb * 2 + nd));
+    const auto delta =
+        0.25 * (u.segment(nb + 1, nd + 1) - u.segment(nb - 1, nd + 1));
+    return (u.segment(nb, nd + 1).array() - (1 + courant) * delta.array())
+        .matrix();
+  }
+
   int n_boundary_cells_;
   int n_domain_cells_;
   double dt_;
@@ -130,6 +254,10 @@ class FrommSpacialReconstructor {
 
 class LaxWendroffSpacialReconstructor {
  public:
+  /// Number of scratch buffers of at most (# of total cells) doubles, which
+  /// the overloads with an arena allocate at once
+  static constexpr int n_arena_buffers = 0;
+
   LaxWendroffSpacialReconstructor(const ProblemParameters& params)
       : n_boundary_cells_{params.n_boundary_cells},
         n_domain_cells_{params.n_domain_cells},
@@ -143,26 +271,66 @@ class LaxWendroffSpacialReconstructor {
   template <typename Derived>
   Eigen::VectorXd calc_left(
       const Eigen::MatrixBase<Derived>& u) const noexcept {
-    assert(u.size() == (n_boundary_cells_ * 2 + n_domain_cells_));
-    const Eigen::VectorXd delta =
-        0.5 * (u.segment(n_boundary_cells_, n_domain_cells_ + 1) -
-               u.segment(n_boundary_cells_ - 1, n_domain_cells_ + 1));
-    return u.segment(n_boundary_cells_ - 1, n_domain_cells_ + 1) +
-           (1 - velocity_ * dt_ / dx_) * delta;
+    return this->calc_left_impl(u, velocity_ * dt_ / dx_);
   }
 
   template <typename Derived>
   Eigen::VectorXd calc_right(
       const Eigen::MatrixBase<Derived>& u) const noexcept {
-    assert(u.size() == (n_boundary_cells_ * 2 + n_domain_cells_));
-    const Eigen::VectorXd delta =
-        0.5 * (u.segment(n_boundary_cells_, n_domain_cells_ + 1) -
-               u.segment(n_boundary_cells_ - 1, n_domain_cells_ + 1));
-    return u.segment(n_boundary_cells_, n_domain_cells_ + 1) -
-           (1 + velocity_ * dt_ / dx_) * delta;
+    return this->calc_right_impl(u, velocity_ * dt_ / dx_);
+  }
+
+  template <typename Derived>
+  Eigen::VectorXd calc_left(const Eigen::MatrixBase<Derived>& u,
+                            const VelocityField& velocity) const noexcept {
+    return this->calc_left_impl(u, velocity.courant());
+  }
+
+  template <typename Derived>
+  Eigen::VectorXd calc_right(const Eigen::MatrixBase<Derived>& u,
+                             const VelocityField& velocity) const noexcept {
+    return this->calc_right_impl(u, velocity.courant());
+  }
+
+  template <typename Derived>
+  void calc_left(const Eigen::MatrixBase<Derived>& u,
+                 Eigen::Ref<Eigen::VectorXd> ul, StateArena&) const noexcept {
+    ul = this->calc_left_impl(u, velocity_ * dt_ / dx_);
+  }
+
+  template <typename Derived>
+  void calc_right(const Eigen::MatrixBase<Derived>& u,
+                  Eigen::Ref<Eigen::VectorXd> ur, StateArena&) const noexcept {
+    ur = this->calc_right_impl(u, velocity_ * dt_ / dx_);
   }
 
  private:
+  /// Expression of values at faces, to be evaluated into the destination
+  template <typename Derived, typename Courant>
+  auto calc_left_impl(const Eigen::MatrixBase<Derived>& u,
+                      const Courant& courant) const noexcept {
+    const auto nb = n_boundary_cells_;
+    const auto nd = n_domain_cells_;
+    assert(u.size() == (nb * 2 + nd));
+    const auto delta =
+        0.5 * (u.segment(nb, nd + 1) - u.segment(nb - 1, nd + 1));
+    return (u.segment(nb - 1, nd + 1).array() + (1 - courant) * delta.array())
+        .matrix();
+  }
+
+  /// Expression of values at faces, to be evaluated into the destination
+  template <typename Derived, typename Courant>
+  auto calc_right_impl(const Eigen::MatrixBase<Derived>& u,
+                       const Courant& courant) const noexcept {
+    const auto nb = n_boundary_cells_;
+    const auto nd = n_domain_cells_;
+    assert(u.size() == (nb * 2 + nd));
+    const auto delta =
+        0.5 * (u.segment(nb, nd + 1) - u.segment(nb - 1, nd + 1));
+    return (u.segment(nb, nd + 1).array() - (1 + courant) * delta.array())
+        .matrix();
+  }
+
   int n_boundary_cells_;
   int n_domain_cells_;
   double dt_;
@@ -173,6 +341,10 @@ class LaxWendroffSpacialReconstructor {
 template <typename SlopeLimiter>
 class TvdSpacialReconstructor {
  public:
+  /// Number of scratch buffers of at most (# of total cells) doubles, which
+  /// the overloads with an arena allocate at once
+  static constexpr int n_arena_buffers = 1;
+
   TvdSpacialReconstructor(const ProblemParameters& params)
       : n_boundary_cells_{params.n_boundary_cells},
         n_domain_cells_{params.n_domain_cells},
@@ -186,50 +358,112 @@ class TvdSpacialReconstructor {
   template <typename Derived>
   Eigen::VectorXd calc_left(
       const Eigen::MatrixBase<Derived>& u) const noexcept {
+    return this->calc_left_impl(u, velocity_ * dt_ / dx_);
+  }
+
+  template <typename Derived>
+  Eigen::VectorXd calc_right(
+      const Eigen::MatrixBase<Derived>& u) const noexcept {
+    return this->calc_right_impl(u, velocity_ * dt_ / dx_);
+  }
+
+  template <typename Derived>
+  Eigen::VectorXd calc_left(const Eigen::MatrixBase<Derived>& u,
+                            const VelocityField& velocity) const noexcept {
+    return this->calc_left_impl(u, velocity.courant());
+  }
+
+  template <typename Derived>
+  Eigen::VectorXd calc_right(const Eigen::MatrixBase<Derived>& u,
+                             const VelocityField& velocity) const noexcept {
+    return this->calc_right_impl(u, velocity.courant());
+  }
+
+  template <typename Derived>
+  void calc_left(const Eigen::MatrixBase<Derived>& u,
+                 Eigen::Ref<Eigen::VectorXd> ul, StateArena& arena) const {
+    StateArena::Scope scope{arena};
+    auto du = arena.allocate(n_domain_cells_ + 2);
+    this->calc_left_impl(u, velocity_ * dt_ / dx_, ul, du);
+  }
+
+  template <typename Derived>
+  void calc_right(const Eigen::MatrixBase<Derived>& u,
+                  Eigen::Ref<Eigen::VectorXd> ur, StateArena& arena) const {
+    StateArena::Scope scope{arena};
+    auto du = arena.allocate(n_domain_cells_ + 2);
+    this->calc_right_impl(u, velocity_ * dt_ / dx_, ur, du);
+  }
+
+ private:
+  template <typename Derived, typename Courant>
+  Eigen::VectorXd calc_left_impl(const Eigen::MatrixBase<Derived>& u,
+                                 const Courant& courant) const noexcept {
+    Eigen::VectorXd ul(n_domain_cells_ + 1);
+    Eigen::VectorXd du(n_domain_cells_ + 2);
+    this->calc_left_impl(u, courant, ul, du);
+    return ul;
+  }
+
+  template <typename Derived, typename Courant>
+  Eigen::VectorXd calc_right_impl(const Eigen::MatrixBase<Derived>& u,
+                                  const Courant& courant) const noexcept {
+    Eigen::VectorXd ur(n_domain_cells_ + 1);
+    Eigen::VectorXd du(n_domain_cells_ + 2);
+    this->calc_right_impl(u, courant, ur, du);
+    return ur;
+  }
+
+  /// Reconstruct into ul with a scratch buffer du of size (nd + 2), where ul
+  /// holds the slope ratio r and then the limiter phi on the way
+  template <typename Derived, typename Courant>
+  void calc_left_impl(const Eigen::MatrixBase<Derived>& u,
+                      const Courant& courant, Eigen::Ref<Eigen::VectorXd> ul,
+                      Eigen::Ref<Eigen::VectorXd> du) const noexcept {
     const auto nb = n_boundary_cells_;
     const auto nd = n_domain_cells_;
     assert(u.size() == (nb * 2 + nd));
+    assert(ul.size() == nd + 1 && du.size() == nd + 2);
     using Eigen::lastN;
     using Eigen::seqN;
-    using Eigen::VectorXd;
-    const VectorXd du = u(seqN(nb - 1, nd + 2)) - u(seqN(nb - 2, nd + 2));
-    const VectorXd r =
-        du(seqN(0, nd + 1))
-            .cwiseQuotient(du(lastN(nd + 1)) +
-                           du(lastN(nd + 1)).unaryExpr([](double x) {
-                             return x >= 0 ? 1e-5 : -1e-5;
-                           }));
-    const VectorXd phi = SlopeLimiter::eval(r);
-    const VectorXd delta =
-        0.5 * (u(seqN(nb, nd + 1)) - u(seqN(nb - 1, nd + 1)));
-    return u(seqN(nb - 1, nd + 1)) +
-           (1 - velocity_ * dt_ / dx_) * phi.cwiseProduct(delta);
+    du = u(seqN(nb - 1, nd + 2)) - u(seqN(nb - 2, nd + 2));
+    ul = du(seqN(0, nd + 1))
+             .cwiseQuotient(du(lastN(nd + 1)) +
+                            du(lastN(nd + 1)).unaryExpr([](double x) {
+                              return x >= 0 ? 1e-5 : -1e-5;
+                            }));
+    SlopeLimiter::eval(ul, ul);
+    const auto delta = 0.5 * (u(seqN(nb, nd + 1)) - u(seqN(nb - 1, nd + 1)));
+    ul = (u(seqN(nb - 1, nd + 1)).array() +
+          (1 - courant) * (ul.array() * delta.array()))
+             .matrix();
   }
 
-  template <typename Derived>
-  Eigen::VectorXd calc_right(
-      const Eigen::MatrixBase<Derived>& u) const noexcept {
+  /// Reconstruct into ur with a scratch buffer du of size (nd + 2), where ur
+  /// holds the slope ratio r and then the limiter phi on the way
+  template <typename Derived, typename Courant>
+  void calc_right_impl(const Eigen::MatrixBase<Derived>& u,
+                       const Courant& courant, Eigen::Ref<Eigen::VectorXd> ur,
+                       Eigen::Ref<Eigen::VectorXd> du) const noexcept {
     const auto nb = n_boundary_cells_;
     const auto nd = n_domain_cells_;
     assert(u.size() == (nb * 2 + nd));
+    assert(ur.size() == nd + 1 && du.size() == nd + 2);
     using Eigen::lastN;
     using Eigen::seqN;
-    using Eigen::VectorXd;
-    const VectorXd du = u(seqN(nb, nd + 2)) - u(seqN(nb - 1, nd + 2));
-    const VectorXd r =
-        du(lastN(nd + 1))
-            .cwiseQuotient(du(seqN(0, nd + 1)) +
-                           du(seqN(0, nd + 1)).unaryExpr([](double x) {
-                             return x >= 0 ? 1e-5 : -1e-5;
-                           }));
-    const VectorXd phi = SlopeLimiter::eval(r);
-    const VectorXd delta =
-        0.5 * (u(seqN(nb, nd + 1)) - u(seqN(nb - 1, nd + 1)));
-    return u(seqN(nb, nd + 1)) -
-           (1 + velocity_ * dt_ / dx_) * phi.cwiseProduct(delta);
+    du = u(seqN(nb, nd + 2)) - u(seqN(nb - 1, nd + 2));
+    ur = du(lastN(nd + 1))
+             .cwiseQuotient(du(seqN(0, nd + 1)) +
+                            du(seqN(0, nd + 1)).unaryExpr([](double x) {
+                              return x >= 0 ? 1e-5 : -1e-5;
+                            }));
+    SlopeLimiter::eval(ur, ur);
+    const auto delta = 0.5 * (u(seqN(nb, nd + 1)) - u(seqN(nb - 1, nd + 1)));
+    ur = (u(seqN(nb, nd + 1)).array() -
+          (1 + courant) * (ur.array() * delta.array()))
+             .matrix();
   }
 
- private:
   int n_boundary_cells_;
   int n_domain_cells_;
   double dt_;
@@ -237,6 +471,462 @@ class TvdSpacialReconstructor {
   double velocity_;
 };
 
+/**
+ * @brief Statistics of faces reconstructed by HybridSpacialReconstructor
+ */
+struct HybridStatistics {
+  long long faces = 0;          ///> Number of reconstructed faces
+  long long limited_faces = 0;  ///> Number of faces reconstructed by TVD
+
+  /// Fraction of faces reconstructed by TVD
+  double limited_fraction() const noexcept {
+    return faces > 0 ? static_cast<double>(limited_faces) /
+                           static_cast<double>(faces)
+                     : 0.0;
+  }
+
+  HybridStatistics& operator+=(const HybridStatistics& other) noexcept {
+    faces += other.faces;
+    limited_faces += other.limited_faces;
+    return *this;
+  }
+};
+
+/**
+ * @brief Hybrid of the Lax-Wendroff and TVD schemes
+ *
+ * Faces are classified block by block with a smoothness indicator of the
+ * adjacent cells,
+ * @f[
+ * |u_{j+1} - 2 u_j + u_{j-1}| \le \kappa \max_k |u_{k+1} - u_k|
+ * @f]
+ * where the maximum is taken over the whole state. Second differences of
+ * resolved smooth waves, including their extrema, are small compared to the
+ * largest first difference, whereas those at discontinuities are comparable
+ * to it. Blocks containing a face next to a non-smooth cell are reconstructed
+ * by the TVD scheme, and the other blocks by the unlimited Lax-Wendroff
+ * scheme, which equals the TVD scheme with @f$ \phi = 1 @f$. Consecutive
+ * blocks of the same kind are reconstructed at once.
+ *
+ * calc_faces() classifies a state once for both sides of faces, and is used
+ * by ScalarAdvectionEquationSimulator. It also accumulates the numbers of
+ * faces and limited faces into statistics(), atomically so that lines can be
+ * reconstructed by several OpenMP threads. calc_left() and calc_right()
+ * classify the state on each call, and are not counted.
+ *
+ * @tparam SlopeLimiter Slope limiter of the TVD scheme
+ */
+template <typename SlopeLimiter>
+class HybridSpacialReconstructor {
+ public:
+  /**
+   * @brief Construct a new Hybrid Spacial Reconstructor object
+   *
+   * @param params Problem parameters
+   * @param threshold Threshold @f$ \kappa @f$ of the smoothness indicator
+   * @param block_size Number of faces of a block
+   */
+  HybridSpacialReconstructor(const ProblemParameters& params,
+                             double threshold = 0.2, int block_size = 8)
+      : params_{params},
+        threshold_{threshold},
+        block_size_{
+            std::max(1, std::min(block_size, params.n_domain_cells + 1))},
+        n_blocks_{(params.n_domain_cells + block_size_) / block_size_} {
+    assert(params.n_boundary_cells >= 2 &&
+           "Hybrid method requires (# of boundary cells >= 2).");
+  }
+
+  /// Number of scratch buffers of at most (# of total cells) doubles, which
+  /// the overloads with an arena allocate at once
+  static constexpr int n_arena_buffers = 2;
+
+  template <typename Derived>
+  Eigen::VectorXd calc_left(
+      const Eigen::MatrixBase<Derived>& u) const noexcept {
+    std::vector<char> limited(n_blocks_);
+    this->mark_limited(u, limited);
+    Eigen::VectorXd ul(params_.n_domain_cells + 1);
+    Eigen::Ref<Eigen::VectorXd> left = ul;
+    this->reconstruct(u, limited, &left, nullptr, nullptr);
+    return ul;
+  }
+
+  template <typename Derived>
+  Eigen::VectorXd calc_right(
+      const Eigen::MatrixBase<Derived>& u) const noexcept {
+    std::vector<char> limited(n_blocks_);
+    this->mark_limited(u, limited);
+    Eigen::VectorXd ur(params_.n_domain_cells + 1);
+    Eigen::Ref<Eigen::VectorXd> right = ur;
+    this->reconstruct(u, limited, nullptr, &right, nullptr);
+    return ur;
+  }
+
+  /**
+   * @brief Reconstruct values on both sides of faces
+   *
+   * @tparam Derived
+   * @param u State including boundary cells
+   * @param ul Values on the left side of faces
+   * @param ur Values on the right side of faces
+   */
+  template <typename Derived>
+  void calc_faces(const Eigen::MatrixBase<Derived>& u, Eigen::VectorXd& ul,
+                  Eigen::VectorXd& ur) const noexcept {
+    std::vector<char> limited(n_blocks_);
+    this->count(this->mark_limited(u, limited));
+    ul.resize(params_.n_domain_cells + 1);
+    ur.resize(params_.n_domain_cells + 1);
+    Eigen::Ref<Eigen::VectorXd> left = ul;
+    Eigen::Ref<Eigen::VectorXd> right = ur;
+    this->reconstruct(u, limited, &left, &right, nullptr);
+  }
+
+  template <typename Derived>
+  void calc_left(const Eigen::MatrixBase<Derived>& u,
+                 Eigen::Ref<Eigen::VectorXd> ul, StateArena& arena) const {
+    StateArena::Scope scope{arena};
+    auto limited = arena.allocate(n_blocks_);
+    this->mark_limited(u, limited);
+    this->reconstruct(u, limited, &ul, nullptr, &arena);
+  }
+
+  template <typename Derived>
+  void calc_right(const Eigen::MatrixBase<Derived>& u,
+                  Eigen::Ref<Eigen::VectorXd> ur, StateArena& arena) const {
+    StateArena::Scope scope{arena};
+    auto limited = arena.allocate(n_blocks_);
+    this->mark_limited(u, limited);
+    this->reconstruct(u, limited, nullptr, &ur, &arena);
+  }
+
+  /**
+   * @brief Reconstruct values on both sides of faces into given buffers
+   *
+   * @tparam Derived
+   * @param u State including boundary cells
+   * @param ul Values on the left side of faces
+   * @param ur Values on the right side of faces
+   * @param arena Arena to allocate scratch buffers
+   */
+  template <typename Derived>
+  void calc_faces(const Eigen::MatrixBase<Derived>& u,
+                  Eigen::Ref<Eigen::VectorXd> ul,
+                  Eigen::Ref<Eigen::VectorXd> ur, StateArena& arena) const {
+    StateArena::Scope scope{arena};
+    auto limited = arena.allocate(n_blocks_);
+    this->count(this->mark_limited(u, limited));
+    this->reconstruct(u, limited, &ul, &ur, &arena);
+  }
+
+  /// Numbers of faces reconstructed by calc_faces() so far
+  const HybridStatistics& statistics() const noexcept { return statistics_; }
+
+ private:
+  int block_faces(int b) const noexcept {
+    return b == n_blocks_ - 1 ? params_.n_domain_cells + 1 - b * block_size_
+                              : block_size_;
+  }
+
+  /// Accumulate the numbers of faces of a state into the statistics
+  void count(long long limited_faces) const noexcept {
+    const long long faces = params_.n_domain_cells + 1;
+#ifdef _OPENMP
+#pragma omp atomic
+    statistics_.faces += faces;
+#pragma omp atomic
+    statistics_.limited_faces += limited_faces;
+#else
+    statistics_.faces += faces;
+    statistics_.limited_faces += limited_faces;
+#endif
+  }
+
+  /**
+   * @brief Mark limited blocks
+   *
+   * @tparam Derived
+   * @tparam Mask std::vector<char> or a buffer of doubles
+   * @param u State including boundary cells
+   * @param limited Whether each block is reconstructed by TVD
+   * @return long long Number of limited faces
+   */
+  template <typename Derived, typename Mask>
+  long long mark_limited(const Eigen::MatrixBase<Derived>& u,
+                         Mask& limited) const noexcept {
+    const auto nb = params_.n_boundary_cells;
+    const auto nd = params_.n_domain_cells;
+    assert(u.size() == (nb * 2 + nd));
+    const Eigen::Ref<const Eigen::VectorXd> state = u;
+    const auto v = state.segment(nb - 2, nd + 4);
+    const double scale =
+        threshold_ * (v.tail(nd + 3) - v.head(nd + 3)).cwiseAbs().maxCoeff();
+    // Second differences of cells adjacent to faces, i.e. from (nb - 1) to
+    // (nb + nd). Block b has faces from (b * block_size), and the first cell
+    // of a block is the last cell of the previous block.
+    for (int b = 0; b < n_blocks_; ++b) {
+      limited[b] = false;
+    }
+    for (int i = 0; i < nd + 2; ++i) {
+      if (std::abs(v(i + 2) - 2 * v(i + 1) + v(i)) > scale) {
+        const int b = std::min(i / block_size_, n_blocks_ - 1);
+        limited[b] = true;
+        if (i == b * block_size_ && b > 0) {
+          limited[b - 1] = true;
+        }
+      }
+    }
+    // Neighbouring blocks are limited as well, so that oscillations of the
+    // Lax-Wendroff scheme do not develop next to discontinuities.
+    long long limited_faces = 0;
+    bool previous = false;
+    for (int b = 0; b < n_blocks_; ++b) {
+      const bool rough = limited[b];
+      limited[b] = rough || previous || (b + 1 < n_blocks_ && limited[b + 1]);
+      limited_faces += limited[b] ? this->block_faces(b) : 0;
+      previous = rough;
+    }
+    return limited_faces;
+  }
+
+  /// Reconstruct runs of blocks of the same kind, with scratch buffers of TVD
+  /// runs in the arena if given
+  template <typename Derived, typename Mask>
+  void reconstruct(const Eigen::MatrixBase<Derived>& u, const Mask& limited,
+                   Eigen::Ref<Eigen::VectorXd>* ul,
+                   Eigen::Ref<Eigen::VectorXd>* ur, StateArena* arena) const {
+    const auto nb = params_.n_boundary_cells;
+    const auto nd = params_.n_domain_cells;
+    const double courant = params_.velocity * params_.dt / params_.dx;
+    const Eigen::Ref<const Eigen::VectorXd> state = u;
+    for (int b = 0; b < n_blocks_;) {
+      int e = b + 1;
+      while (e < n_blocks_ && limited[e] == limited[b]) {
+        ++e;
+      }
+      const int first = b * block_size_;
+      const int n = (e == n_blocks_ ? nd + 1 : e * block_size_) - first;
+      if (limited[b]) {
+        // A run of n faces has (n - 1) cells.
+        auto run_params = params_;
+        run_params.n_domain_cells = n - 1;
+        const TvdSpacialReconstructor<SlopeLimiter> tvd{run_params};
+        const Eigen::Map<const Eigen::VectorXd> view(state.data() + first,
+                                                     n - 1 + 2 * nb);
+        if (ul && arena) {
+          tvd.calc_left(view, ul->segment(first, n), *arena);
+        } else if (ul) {
+          ul->segment(first, n) = tvd.calc_left(view);
+        }
+        if (ur && arena) {
+          tvd.calc_right(view, ur->segment(first, n), *arena);
+        } else if (ur) {
+          ur->segment(first, n) = tvd.calc_right(view);
+        }
+      } else {
+        // Lax-Wendroff scheme, written to faces without temporaries
+        const auto left = state.segment(nb - 1 + first, n).array();
+        const auto right = state.segment(nb + first, n).array();
+        if (ul) {
+          ul->segment(first, n).array() =
+              left + (0.5 * (1 - courant)) * (right - left);
+        }
+        if (ur) {
+          ur->segment(first, n).array() =
+              right - (0.5 * (1 + courant)) * (right - left);
+        }
+      }
+      b = e;
+    }
+  }
+
+  ProblemParameters params_;
+  double threshold_;
+  int block_size_;
+  int n_blocks_;
+  mutable HybridStatistics statistics_;
+};
+
+/**
+ * @brief Nonlinear weights of the WENO-JS scheme
+ *
+ * @f[
+ * \alpha_k = \frac{d_k}{(\epsilon + \beta_k)^2}
+ * @f]
+ */
+struct WenoJsWeights {
+  static constexpr double eps = 1e-6;
+
+  template <typename Array>
+  static void eval(const Array& beta0, const Array& beta1, const Array& beta2,
+                   Array& alpha0, Array& alpha1, Array& alpha2) noexcept {
+    alpha0 = 0.1 / (eps + beta0).square();
+    alpha1 = 0.6 / (eps + beta1).square();
+    alpha2 = 0.3 / (eps + beta2).square();
+  }
+};
+
+/**
+ * @brief Nonlinear weights of the WENO-Z scheme
+ *
+ * @f[
+ * \alpha_k = d_k \left( 1 + \frac{\tau_5}{\epsilon + \beta_k} \right),
+ * \quad \tau_5 = |\beta_0 - \beta_2|
+ * @f]
+ */
+struct WenoZWeights {
+  static constexpr double eps = 1e-40;
+
+  template <typename Array>
+  static void eval(const Array& beta0, const Array& beta1, const Array& beta2,
+                   Array& alpha0, Array& alpha1, Array& alpha2) noexcept {
+    // Expression, which is evaluated for each weight without a temporary
+    const auto tau5 = (beta0 - beta2).abs();
+    alpha0 = 0.1 * (1 + tau5 / (eps + beta0));
+    alpha1 = 0.6 * (1 + tau5 / (eps + beta1));
+    alpha2 = 0.3 * (1 + tau5 / (eps + beta2));
+  }
+};
+
+/**
+ * @brief Fifth-order WENO reconstruction
+ *
+ * The value at a cell face is a convex combination of three third-order
+ * candidates on the sub-stencils of a five-cell stencil. Smoothness
+ * indicators and nonlinear weights are evaluated as array expressions over
+ * all faces without branches, so that they are vectorized.
+ *
+ * @tparam NonlinearWeights WenoJsWeights or WenoZWeights
+ */
+template <typename NonlinearWeights>
+class Weno5SpacialReconstructor {
+ public:
+  Weno5SpacialReconstructor(const ProblemParameters& params)
+      : n_boundary_cells_{params.n_boundary_cells},
+        n_domain_cells_{params.n_domain_cells} {
+    assert(params.n_boundary_cells >= 3 &&
+           "WENO5 method requires (# of boundary cells >= 3).");
+  }
+
+  /// Number of scratch buffers of at most (# of total cells) doubles, which
+  /// the overloads with an arena allocate at once
+  static constexpr int n_arena_buffers = 6;
+
+  template <typename Derived>
+  Eigen::VectorXd calc_left(
+      const Eigen::MatrixBase<Derived>& u) const noexcept {
+    Eigen::VectorXd ul(n_domain_cells_ + 1);
+    std::array<Eigen::ArrayXd, 6> scratch;
+    this->calc_left_impl(u, ul, scratch);
+    return ul;
+  }
+
+  template <typename Derived>
+  Eigen::VectorXd calc_right(
+      const Eigen::MatrixBase<Derived>& u) const noexcept {
+    Eigen::VectorXd ur(n_domain_cells_ + 1);
+    std::array<Eigen::ArrayXd, 6> scratch;
+    this->calc_right_impl(u, ur, scratch);
+    return ur;
+  }
+
+  template <typename Derived>
+  Eigen::VectorXd calc_left(const Eigen::MatrixBase<Derived>& u,
+                            const VelocityField&) const noexcept {
+    return this->calc_left(u);
+  }
+
+  template <typename Derived>
+  Eigen::VectorXd calc_right(const Eigen::MatrixBase<Derived>& u,
+                             const VelocityField&) const noexcept {
+    return this->calc_right(u);
+  }
+
+  template <typename Derived>
+  void calc_left(const Eigen::MatrixBase<Derived>& u,
+                 Eigen::Ref<Eigen::VectorXd> ul, StateArena& arena) const {
+    StateArena::Scope scope{arena};
+    auto scratch = this->allocate_scratch(arena);
+    this->calc_left_impl(u, ul, scratch);
+  }
+
+  template <typename Derived>
+  void calc_right(const Eigen::MatrixBase<Derived>& u,
+                  Eigen::Ref<Eigen::VectorXd> ur, StateArena& arena) const {
+    StateArena::Scope scope{arena};
+    auto scratch = this->allocate_scratch(arena);
+    this->calc_right_impl(u, ur, scratch);
+  }
+
+ private:
+  using ScratchArray = Eigen::Map<Eigen::ArrayXd, Eigen::Aligned64>;
+
+  /// Scratch arrays of smoothness indicators and weights in an arena
+  std::array<ScratchArray, 6> allocate_scratch(StateArena& arena) const {
+    const auto n = n_domain_cells_ + 1;
+    const auto allocate = [&arena, n] {
+      return ScratchArray(arena.allocate(n).data(), n);
+    };
+    return {allocate(), allocate(), allocate(),
+            allocate(), allocate(), allocate()};
+  }
+
+  template <typename Derived, typename Array>
+  void calc_left_impl(const Eigen::MatrixBase<Derived>& u,
+                      Eigen::Ref<Eigen::VectorXd> ul,
+                      std::array<Array, 6>& scratch) const noexcept {
+    const auto nb = n_boundary_cells_;
+    const auto nd = n_domain_cells_;
+    assert(u.size() == (nb * 2 + nd));
+    using Eigen::seqN;
+    reconstruct(u(seqN(nb - 3, nd + 1)).array(),
+                u(seqN(nb - 2, nd + 1)).array(),
+                u(seqN(nb - 1, nd + 1)).array(), u(seqN(nb, nd + 1)).array(),
+                u(seqN(nb + 1, nd + 1)).array(), ul, scratch);
+  }
+
+  template <typename Derived, typename Array>
+  void calc_right_impl(const Eigen::MatrixBase<Derived>& u,
+                       Eigen::Ref<Eigen::VectorXd> ur,
+                       std::array<Array, 6>& scratch) const noexcept {
+    const auto nb = n_boundary_cells_;
+    const auto nd = n_domain_cells_;
+    assert(u.size() == (nb * 2 + nd));
+    using Eigen::seqN;
+    reconstruct(u(seqN(nb + 2, nd + 1)).array(),
+                u(seqN(nb + 1, nd + 1)).array(), u(seqN(nb, nd + 1)).array(),
+                u(seqN(nb - 1, nd + 1)).array(),
+                u(seqN(nb - 2, nd + 1)).array(), ur, scratch);
+  }
+
+  /**
+   * @brief Reconstruct the value at the face between c and d from the stencil
+   * (a, b, c, d, e), where a is the farthest upwind cell, into v with scratch
+   * arrays for smoothness indicators and weights.
+   */
+  template <typename A, typename B, typename C, typename D, typename E,
+            typename Array>
+  static void reconstruct(const A& a, const B& b, const C& c, const D& d,
+                          const E& e, Eigen::Ref<Eigen::VectorXd> v,
+                          std::array<Array, 6>& scratch) noexcept {
+    auto& [beta0, beta1, beta2, alpha0, alpha1, alpha2] = scratch;
+    beta0 = (13.0 / 12.0) * (a - 2 * b + c).square() +
+            0.25 * (a - 4 * b + 3 * c).square();
+    beta1 = (13.0 / 12.0) * (b - 2 * c + d).square() + 0.25 * (b - d).square();
+    beta2 = (13.0 / 12.0) * (c - 2 * d + e).square() +
+            0.25 * (3 * c - 4 * d + e).square();
+    NonlinearWeights::eval(beta0, beta1, beta2, alpha0, alpha1, alpha2);
+    v = ((alpha0 * (2 * a - 7 * b + 11 * c) + alpha1 * (-b + 5 * c + 2 * d) +
+          alpha2 * (2 * c + 5 * d - e)) /
+         (6 * (alpha0 + alpha1 + alpha2)))
+            .matrix();
+  }
+
+  int n_boundary_cells_;
+  int n_domain_cells_;
+};
+
 }  // namespace cfd
 
 #endif  // CFD_SPACIAL_RECONSTRUCTION_SCHEMES_HPP
\ No newline at end of file
@@ -0,0 +1,252 @@
+#ifndef CFD_STATE_ARENA_HPP
+#define CFD_STATE_ARENA_HPP
+
+#include <Eigen/Core>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace cfd {
+
+/**
+ * @brief How a StateArena is backed by huge pages
+ */
+enum class HugePagePolicy {
+  none,         ///> Regular pages
+  transparent,  ///> Transparent huge pages via madvise(MADV_HUGEPAGE)
+  hugetlb,      ///> Explicit huge pages via MAP_HUGETLB if available,
+                ///> otherwise transparent huge pages
+};
+
+/**
+ * @brief Arena which places simulation buffers in one 64-byte aligned block
+ *
+ * Buffers are handed out by bumping an offset, and reset() makes the whole
+ * block available again without returning it to the operating system. Thus
+ * successive runs and ensemble members reuse pages which are already faulted
+ * in. The block is mapped lazily, so each page is first touched by the thread
+ * which first writes to it.
+ *
+ * Scratch buffers of a time step are allocated within a Scope, which returns
+ * them to the arena at its end, so that the peak usage does not grow with
+ * the number of time steps.
+ */
+class StateArena {
+ public:
+  static constexpr std::size_t alignment = 64;
+
+  using Buffer = Eigen::Map<Eigen::VectorXd, Eigen::Aligned64>;
+
+  /**
+   * @brief Scope which frees the buffers allocated within it at its end
+   */
+  class Scope {
+   public:
+    explicit Scope(StateArena& arena) noexcept
+        : arena_{arena}, used_{arena.used_} {}
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    ~Scope() { arena_.used_ = used_; }
+
+   private:
+    StateArena& arena_;
+    std::size_t used_;  ///> Bytes in use at the beginning of the scope
+  };
+
+  explicit StateArena(HugePagePolicy policy = HugePagePolicy::none) noexcept
+      : policy_{policy} {}
+
+  StateArena(const StateArena&) = delete;
+  StateArena& operator=(const StateArena&) = delete;
+
+  StateArena(StateArena&& other) noexcept
+      : policy_{other.policy_},
+        data_{std::exchange(other.data_, nullptr)},
+        mapped_bytes_{std::exchange(other.mapped_bytes_, 0)},
+        capacity_{std::exchange(other.capacity_, 0)},
+        used_{std::exchange(other.used_, 0)},
+        huge_pages_{std::exchange(other.huge_pages_, false)} {}
+
+  StateArena& operator=(StateArena&& other) noexcept {
+    if (this != &other) {
+      this->release();
+      policy_ = other.policy_;
+      data_ = std::exchange(other.data_, nullptr);
+      mapped_bytes_ = std::exchange(other.mapped_bytes_, 0);
+      capacity_ = std::exchange(other.capacity_, 0);
+      used_ = std::exchange(other.used_, 0);
+      huge_pages_ = std::exchange(other.huge_pages_, false);
+    }
+    return *this;
+  }
+
+  ~StateArena() { this->release(); }
+
+  /**
+   * @brief Ensure that buffers with the given total number of doubles fit
+   *
+   * Growing the block discards it, so this must be called while no buffer is
+   * in use, i.e. right after construction or reset().
+   *
+   * @param n_doubles Total number of doubles of all buffers
+   * @param n_buffers Number of buffers, each of which may be padded
+   */
+  void reserve(Eigen::Index n_doubles, int n_buffers = 1) {
+    const auto bytes = static_cast<std::size_t>(n_doubles) * sizeof(double) +
+                       static_cast<std::size_t>(n_buffers) * alignment;
+    if (bytes <= capacity_) {
+      return;
+    }
+    assert(used_ == 0 && "StateArena cannot grow while buffers are in use.");
+    this->release();
+    this->map(bytes);
+  }
+
+  /**
+   * @brief Allocate a buffer of @f$ n @f$ doubles
+   *
+   * The contents of a buffer are not initialized.
+   *
+   * @param n Number of doubles
+   * @return Buffer Buffer aligned to 64 bytes
+   * @throw std::bad_alloc if the reserved capacity is exceeded
+   */
+  Buffer allocate(Eigen::Index n) {
+    const auto bytes = round_up(static_cast<std::size_t>(n) * sizeof(double));
+    if (used_ + bytes > capacity_) {
+      throw std::bad_alloc();
+    }
+    auto* p = reinterpret_cast<double*>(static_cast<char*>(data_) + used_);
+    used_ += bytes;
+    return Buffer(p, n);
+  }
+
+  /// Make all buffers available again while keeping the block
+  void reset() noexcept { used_ = 0; }
+
+  /// Capacity in bytes
+  std::size_t capacity() const noexcept { return capacity_; }
+
+  /// Bytes in use
+  std::size_t used() const noexcept { return used_; }
+
+  /// Whether the block is backed by huge pages
+  bool huge_pages() const noexcept { return huge_pages_; }
+
+ private:
+  static constexpr std::size_t huge_page_size = std::size_t{2} << 20;
+
+  static constexpr std::size_t round_up(std::size_t bytes,
+                                        std::size_t unit = alignment) noexcept {
+    return (bytes + unit - 1) / unit * unit;
+  }
+
+  void map(std::size_t bytes) {
+#if defined(__unix__) || defined(__APPLE__)
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#if defined(MAP_HUGETLB)
+    if (policy_ == HugePagePolicy::hugetlb) {
+      const auto size = round_up(bytes, huge_page_size);
+      void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB,
+                     -1, 0);
+      if (p != MAP_FAILED) {
+        data_ = p;
+        mapped_bytes_ = size;
+        capacity_ = size;
+        huge_pages_ = true;
+        return;
+      }
+    }
+#endif
+    if (policy_ == HugePagePolicy::none) {
+      const auto size = round_up(bytes, 4096);
+      void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+      if (p == MAP_FAILED) {
+        throw std::bad_alloc();
+      }
+      data_ = p;
+      mapped_bytes_ = size;
+      capacity_ = size;
+      return;
+    }
+
+    // Over-map by one huge page, so that the block can start at a huge page
+    // boundary, and unmap the unaligned head and tail.
+    const auto size = round_up(bytes, huge_page_size);
+    const auto mapped = size + huge_page_size;
+    void* p = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (p == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    const auto address = reinterpret_cast<std::uintptr_t>(p);
+    const auto aligned = round_up(address, huge_page_size);
+    const auto head = aligned - address;
+    if (head > 0) {
+      munmap(p, head);
+    }
+    if (mapped - head > size) {
+      munmap(reinterpret_cast<void*>(aligned + size), mapped - head - size);
+    }
+    data_ = reinterpret_cast<void*>(aligned);
+    mapped_bytes_ = size;
+    capacity_ = size;
+#if defined(MADV_HUGEPAGE)
+    huge_pages_ = madvise(data_, size, MADV_HUGEPAGE) == 0;
+#endif
+#elif defined(_WIN32)
+    const auto size = round_up(bytes, 4096);
+    void* p =
+        VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (p == nullptr) {
+      throw std::bad_alloc();
+    }
+    data_ = p;
+    mapped_bytes_ = size;
+    capacity_ = size;
+#else
+    const auto size = round_up(bytes);
+    data_ = ::operator new(size, std::align_val_t{alignment});
+    mapped_bytes_ = size;
+    capacity_ = size;
+#endif
+  }
+
+  void release() noexcept {
+    if (data_ == nullptr) {
+      return;
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    munmap(data_, mapped_bytes_);
+#elif defined(_WIN32)
+    VirtualFree(data_, 0, MEM_RELEASE);
+#else
+    ::operator delete(data_, std::align_val_t{alignment});
+#endif
+    data_ = nullptr;
+    mapped_bytes_ = 0;
+    capacity_ = 0;
+    used_ = 0;
+    huge_pages_ = false;
+  }
+
+  HugePagePolicy policy_;
+  void* data_ = nullptr;
+  std::size_t mapped_bytes_ = 0;
+  std::size_t capacity_ = 0;
+  std::size_t used_ = 0;
+  bool huge_pages_ = false;
+};
+
+}  // namespace cfd
+
+#endif  // CFD_STATE_ARENA_HPP
@@ -0,0 +1,139 @@
+#ifndef CFD_THREAD_AFFINITY_HPP
+#define CFD_THREAD_AFFINITY_HPP
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace cfd {
+
+/**
+ * @brief Returns the socket (physical package) of a logical CPU
+ *
+ * @param cpu Logical CPU
+ * @return int Socket ID, or 0 if the topology is unknown
+ */
+inline int cpu_socket(int cpu) {
+#if defined(__linux__)
+  std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) +
+                     "/topology/physical_package_id");
+  int socket = 0;
+  if (file >> socket && socket >= 0) {
+    return socket;
+  }
+#endif
+  static_cast<void>(cpu);
+  return 0;
+}
+
+/**
+ * @brief Returns logical CPUs available to this process, ordered by socket so
+ * that consecutive threads are placed on the same socket
+ *
+ * @return std::vector<int> Logical CPUs
+ */
+inline std::vector<int> available_cpus() {
+  std::vector<int> cpus;
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+  if (cpus.empty()) {
+    const int n = std::max(1u, std::thread::hardware_concurrency());
+    for (int cpu = 0; cpu < n; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  std::vector<std::pair<int, int>> keys;
+  keys.reserve(cpus.size());
+  for (const auto cpu : cpus) {
+    keys.emplace_back(cpu_socket(cpu), cpu);
+  }
+  std::sort(keys.begin(), keys.end());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    cpus[i] = keys[i].second;
+  }
+  return cpus;
+}
+
+/**
+ * @brief Pins the calling thread to a logical CPU while in scope
+ *
+ * The previous affinity of the thread is restored on destruction, so that
+ * pooled threads, e.g. of OpenMP, are not left pinned.
+ */
+class ScopedThreadPin {
+ public:
+  /**
+   * @brief Construct a new Scoped Thread Pin object
+   *
+   * @param cpu Logical CPU
+   */
+  explicit ScopedThreadPin(int cpu) noexcept {
+#if defined(__linux__)
+    if (cpu < 0 || cpu >= CPU_SETSIZE ||
+        pthread_getaffinity_np(pthread_self(), sizeof(previous_),
+                               &previous_) != 0) {
+      return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pinned_ = pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+    if (cpu < 0 || cpu >= 64) {
+      return;
+    }
+    previous_ = SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{1} << cpu);
+    pinned_ = previous_ != 0;
+#else
+    static_cast<void>(cpu);
+#endif
+  }
+
+  ScopedThreadPin(const ScopedThreadPin&) = delete;
+  ScopedThreadPin& operator=(const ScopedThreadPin&) = delete;
+
+  ~ScopedThreadPin() {
+    if (!pinned_) {
+      return;
+    }
+#if defined(__linux__)
+    pthread_setaffinity_np(pthread_self(), sizeof(previous_), &previous_);
+#elif defined(_WIN32)
+    SetThreadAffinityMask(GetCurrentThread(), previous_);
+#endif
+  }
+
+  /// Whether the thread is pinned
+  bool pinned() const noexcept { return pinned_; }
+
+ private:
+#if defined(__linux__)
+  cpu_set_t previous_;
+#elif defined(_WIN32)
+  DWORD_PTR previous_ = 0;
+#endif
+  bool pinned_ = false;
+};
+
+}  // namespace cfd
+
+#endif  // CFD_THREAD_AFFINITY_HPP
@@ -2,11 +2,29 @@
 #define CFD_TIME_INTEGRATION_SCHEMES_HPP
 
 #include <Eigen/Core>
+#include <array>
+#include <cstddef>
 
 #include "cfd/problem_parameters.hpp"
+#include "cfd/state_arena.hpp"
 
 namespace cfd {
 
+/**
+ * @brief Tag of the axis along which the cells of a matrix-valued state are
+ * laid out
+ *
+ * @tparam Axis 0 if each row is a cell, and 1 if each column is a cell
+ */
+template <int Axis>
+struct CellAxis {};
+
+/// Cells of a state of size (# of variables, # of cells)
+using CellsAsColumns = CellAxis<1>;
+
+/// Cells of a state of size (# of cells, # of variables)
+using CellsAsRows = CellAxis<0>;
+
 /**
  * @brief Time integration with explicit Euler scheme
  *
@@ -20,6 +38,18 @@ namespace cfd {
  */
 class ExplicitEulerScheme {
  public:
+  /// Number of scratch buffers of at most (# of total cells) doubles, which
+  /// advance() with an arena allocates at once
+  static constexpr int n_arena_buffers = 1;
+
+  /// Number of states of the size of @f$ u @f$, which advance() with stage
+  /// buffers uses
+  static constexpr int n_stage_buffers = 0;
+
+  /// Times at which advance() evaluates numerical flux, in units of the time
+  /// step length from its beginning, in the order of evaluation
+  static constexpr std::array<double, 1> stage_times = {0.0};
+
   /**
    * @brief Construct a new Explicit Euler Scheme object
    *
@@ -57,10 +87,154 @@ class ExplicitEulerScheme {
   template <typename Derived1, typename Derived2>
   void update(Eigen::MatrixBase<Derived1>& u,
               const Eigen::MatrixBase<Derived2>& f) const noexcept {
-    assert(u.size() == (n_boundary_cells_ * 2 + n_domain_cells_));
-    assert(f.size() == (n_domain_cells_ + 1));
-    u.segment(n_boundary_cells_, n_domain_cells_) -=
-        (dt_ / dx_) * (f.tail(n_domain_cells_) - f.head(n_domain_cells_));
+    static_assert(Derived1::IsVectorAtCompileTime,
+                  "A matrix-valued state requires its cell axis.");
+    const auto nb = n_boundary_cells_;
+    const auto nd = n_domain_cells_;
+    assert(u.size() == (nb * 2 + nd));
+    assert(f.size() == (nd + 1));
+    u.segment(nb, nd) -= (dt_ / dx_) * (f.tail(nd) - f.head(nd));
+  }
+
+  /**
+   * @brief Update a matrix @f$ u @f$ holding several variables whose cells are
+   * columns
+   *
+   * @tparam Derived1
+   * @tparam Derived2
+   * @param u Variable to solve of size (# of variables, # of total cells)
+   * @param f Numerical flux of size (# of variables, # of domain cells + 1)
+   */
+  template <typename Derived1, typename Derived2>
+  void update(Eigen::MatrixBase<Derived1>& u,
+              const Eigen::MatrixBase<Derived2>& f,
+              CellsAsColumns) const noexcept {
+    const auto nb = n_boundary_cells_;
+    const auto nd = n_domain_cells_;
+    assert(u.cols() == (nb * 2 + nd));
+    assert(f.cols() == (nd + 1) && f.rows() == u.rows());
+    u.middleCols(nb, nd) -= (dt_ / dx_) * (f.rightCols(nd) - f.leftCols(nd));
+  }
+
+  /**
+   * @brief Update a matrix @f$ u @f$ holding several variables whose cells are
+   * rows
+   *
+   * @tparam Derived1
+   * @tparam Derived2
+   * @param u Variable to solve of size (# of total cells, # of variables)
+   * @param f Numerical flux of size (# of domain cells + 1, # of variables)
+   */
+  template <typename Derived1, typename Derived2>
+  void update(Eigen::MatrixBase<Derived1>& u,
+              const Eigen::MatrixBase<Derived2>& f,
+              CellsAsRows) const noexcept {
+    const auto nb = n_boundary_cells_;
+    const auto nd = n_domain_cells_;
+    assert(u.rows() == (nb * 2 + nd));
+    assert(f.rows() == (nd + 1) && f.cols() == u.cols());
+    u.middleRows(nb, nd) -= (dt_ / dx_) * (f.bottomRows(nd) - f.topRows(nd));
+  }
+
+  /**
+   * @brief Update @f$ u @f$ with numerical flux in a scratch buffer
+   *
+   * @tparam Derived
+   * @tparam FluxFunction
+   * @param u Variable to solve
+   * @param calc_flux Function writing numerical flux for given @f$ u @f$
+   * into a given buffer
+   * @param arena Arena to allocate the buffer of numerical flux
+   */
+  template <typename Derived, typename FluxFunction>
+  void update(Eigen::MatrixBase<Derived>& u, FluxFunction&& calc_flux,
+              StateArena& arena) const {
+    StateArena::Scope scope{arena};
+    auto f = arena.allocate(n_domain_cells_ + 1);
+    calc_flux(u, f);
+    this->update(u, f);
+  }
+
+  /**
+   * @brief Advance @f$ u @f$ by one time step
+   *
+   * @tparam Derived
+   * @tparam FluxFunction
+   * @tparam BoundaryFunction
+   * @param u Variable to solve
+   * @param calc_flux Function returning numerical flux for given @f$ u @f$
+   * @param apply_boundary Function applying boundary conditions to @f$ u @f$
+   */
+  template <typename Derived, typename FluxFunction, typename BoundaryFunction>
+  void advance(Eigen::MatrixBase<Derived>& u, FluxFunction&& calc_flux,
+               BoundaryFunction&& apply_boundary) const noexcept {
+    this->update(u, calc_flux(u));
+    apply_boundary(u);
+  }
+
+  /**
+   * @brief Advance a matrix @f$ u @f$ holding several variables by one time
+   * step
+   *
+   * @tparam Derived
+   * @tparam FluxFunction
+   * @tparam BoundaryFunction
+   * @tparam Axis
+   * @param u Variable to solve
+   * @param calc_flux Function returning numerical flux for given @f$ u @f$
+   * @param apply_boundary Function applying boundary conditions to @f$ u @f$
+   * @param axis Axis along which cells are laid out
+   */
+  template <typename Derived, typename FluxFunction, typename BoundaryFunction,
+            int Axis>
+  void advance(Eigen::MatrixBase<Derived>& u, FluxFunction&& calc_flux,
+               BoundaryFunction&& apply_boundary,
+               CellAxis<Axis> axis) const noexcept {
+    this->update(u, calc_flux(u), axis);
+    apply_boundary(u);
+  }
+
+  /**
+   * @brief Advance a matrix @f$ u @f$ holding several variables by one time
+   * step, ignoring stage buffers owned by the caller since this scheme needs
+   * none
+   *
+   * @tparam Derived
+   * @tparam FluxFunction
+   * @tparam BoundaryFunction
+   * @tparam Axis
+   * @tparam State
+   * @tparam N
+   * @param u Variable to solve
+   * @param calc_flux Function returning numerical flux for given @f$ u @f$
+   * @param apply_boundary Function applying boundary conditions to @f$ u @f$
+   * @param axis Axis along which cells are laid out
+   */
+  template <typename Derived, typename FluxFunction, typename BoundaryFunction,
+            int Axis, typename State, std::size_t N>
+  void advance(Eigen::MatrixBase<Derived>& u, FluxFunction&& calc_flux,
+               BoundaryFunction&& apply_boundary, CellAxis<Axis> axis,
+               std::array<State, N>&) const noexcept {
+    this->advance(u, calc_flux, apply_boundary, axis);
+  }
+
+  /**
+   * @brief Advance @f$ u @f$ by one time step with scratch buffers in an arena
+   *
+   * @tparam Derived
+   * @tparam FluxFunction
+   * @tparam BoundaryFunction
+   * @param u Variable to solve
+   * @param calc_flux Function writing numerical flux for given @f$ u @f$
+   * into a given buffer
+   * @param apply_boundary Function applying boundary conditions to @f$ u @f$
+   * @param arena Arena to allocate scratch buffers
+   */
+  template <typename Derived, typename FluxFunction, typename BoundaryFunction>
+  void advance(Eigen::MatrixBase<Derived>& u, FluxFunction&& calc_flux,
+               BoundaryFunction&& apply_boundary, StateArena& arena) const {
+    this->update(u, calc_flux, arena);
+    apply_boundary(u);
   }
 
  private:
@@ -70,6 +244,208 @@ class ExplicitEulerScheme {
   int n_domain_cells_;
 };
 
+/**
+ * @brief Time integration with the third-order strong stability preserving
+ * Runge-Kutta (SSP-RK3) scheme
+ *
+ * @f[
+ * \begin{aligned}
+ * u^{(1)} &= u^n + \Delta t L(u^n) \\
+ * u^{(2)} &= \frac{3}{4} u^n + \frac{1}{4} (u^{(1)} + \Delta t L(u^{(1)}))
+ * \\
+ * u^{n+1} &= \frac{1}{3} u^n + \frac{2}{3} (u^{(2)} + \Delta t L(u^{(2)}))
+ * \end{aligned}
+ * @f]
+ * where each stage is an explicit Euler step. It is suitable for
+ * reconstructions which do not depend on the time step length, such as WENO.
+ */
+class SspRungeKutta3Scheme {
+ public:
+  /// Number of scratch buffers of at most (# of total cells) doubles, which
+  /// advance() with an arena allocates at once
+  static constexpr int n_arena_buffers =
+      2 + ExplicitEulerScheme::n_arena_buffers;
+
+  /// Number of states of the size of @f$ u @f$, which advance() with stage
+  /// buffers uses
+  static constexpr int n_stage_buffers = 2;
+
+  /// Times at which advance() evaluates numerical flux, in units of the time
+  /// step length from its beginning, in the order of evaluation
+  static constexpr std::array<double, 3> stage_times = {0.0, 1.0, 0.5};
+
+  /**
+   * @brief Construct a new SSP Runge-Kutta 3 Scheme object
+   *
+   * @param params Problem parameters
+   */
+  SspRungeKutta3Scheme(const ProblemParameters& params)
+      : euler_{params}, dt_{params.dt} {}
+
+  /**
+   * @brief Advance @f$ u @f$ by one time step
+   *
+   * @tparam Derived
+   * @tparam FluxFunction
+   * @tparam BoundaryFunction
+   * @param u Variable to solve
+   * @param calc_flux Function returning numerical flux for given @f$ u @f$
+   * @param apply_boundary Function applying boundary conditions to @f$ u @f$
+   */
+  template <typename Derived, typename FluxFunction, typename BoundaryFunction>
+  void advance(Eigen::MatrixBase<Derived>& u, FluxFunction&& calc_flux,
+               BoundaryFunction&& apply_boundary) const noexcept {
+    using State = typename Derived::PlainObject;
+    State u0, v;
+    this->advance_stages(
+        u, [this, &calc_flux](auto& v) { euler_.update(v, calc_flux(v)); },
+        apply_boundary, u0, v);
+  }
+
+  /**
+   * @brief Advance a matrix @f$ u @f$ holding several variables by one time
+   * step
+   *
+   * @tparam Derived
+   * @tparam FluxFunction
+   * @tparam BoundaryFunction
+   * @tparam Axis
+   * @param u Variable to solve
+   * @param calc_flux Function returning numerical flux for given @f$ u @f$
+   * @param apply_boundary Function applying boundary conditions to @f$ u @f$
+   * @param axis Axis along which cells are laid out
+   */
+  template <typename Derived, typename FluxFunction, typename BoundaryFunction,
+            int Axis>
+  void advance(Eigen::MatrixBase<Derived>& u, FluxFunction&& calc_flux,
+               BoundaryFunction&& apply_boundary,
+               CellAxis<Axis> axis) const noexcept {
+    using State = typename Derived::PlainObject;
+    State u0, v;
+    this->advance_stages(
+        u,
+        [this, &calc_flux, axis](auto& v) {
+          euler_.update(v, calc_flux(v), axis);
+        },
+        apply_boundary, u0, v);
+  }
+
+  /**
+   * @brief Advance a matrix @f$ u @f$ holding several variables by one time
+   * step with stage buffers owned by the caller
+   *
+   * Stage buffers are resized to @f$ u @f$ if needed, so they allocate only
+   * in the first time step when reused across time steps.
+   *
+   * @tparam Derived
+   * @tparam FluxFunction
+   * @tparam BoundaryFunction
+   * @tparam Axis
+   * @tparam State
+   * @tparam N
+   * @param u Variable to solve
+   * @param calc_flux Function returning numerical flux for given @f$ u @f$
+   * @param apply_boundary Function applying boundary conditions to @f$ u @f$
+   * @param axis Axis along which cells are laid out
+   * @param stages At least n_stage_buffers stage buffers
+   */
+  template <typename Derived, typename FluxFunction, typename BoundaryFunction,
+            int Axis, typename State, std::size_t N>
+  void advance(Eigen::MatrixBase<Derived>& u, FluxFunction&& calc_flux,
+               BoundaryFunction&& apply_boundary, CellAxis<Axis> axis,
+               std::array<State, N>& stages) const noexcept {
+    static_assert(N >= n_stage_buffers, "Too few stage buffers.");
+    this->advance_stages(
+        u,
+        [this, &calc_flux, axis](auto& v) {
+          euler_.update(v, calc_flux(v), axis);
+        },
+        apply_boundary, stages[0], stages[1]);
+  }
+
+  /**
+   * @brief Advance @f$ u @f$ by one time step with scratch buffers in an arena
+   *
+   * @tparam Derived
+   * @tparam FluxFunction
+   * @tparam BoundaryFunction
+   * @param u Variable to solve
+   * @param calc_flux Function writing numerical flux for given @f$ u @f$
+   * into a given buffer
+   * @param apply_boundary Function applying boundary conditions to @f$ u @f$
+   * @param arena Arena to allocate scratch buffers
+   */
+  template <typename Derived, typename FluxFunction, typename BoundaryFunction>
+  void advance(Eigen::MatrixBase<Derived>& u, FluxFunction&& calc_flux,
+               BoundaryFunction&& apply_boundary, StateArena& arena) const {
+    StateArena::Scope scope{arena};
+    auto u0 = arena.allocate(u.size());
+    auto v = arena.allocate(u.size());
+    u0 = u;
+
+    v = u0;
+    euler_.update(v, calc_flux, arena);
+    apply_boundary(v);
+
+    euler_.update(v, calc_flux, arena);
+    v = 0.75 * u0 + 0.25 * v;
+    apply_boundary(v);
+
+    euler_.update(v, calc_flux, arena);
+    u = (1.0 / 3.0) * u0 + (2.0 / 3.0) * v;
+    apply_boundary(u);
+  }
+
+  /**
+   * @brief Advance @f$ u @f$ by one time step of @f$ du/dt = L(u) @f$
+   *
+   * This is for semi-discretizations which provide the time derivative
+   * directly instead of numerical flux, such as discontinuous Galerkin
+   * methods.
+   *
+   * @tparam Derived
+   * @tparam RhsFunction
+   * @param u Variable to solve
+   * @param calc_rhs Function returning @f$ L(u) @f$ for given @f$ u @f$
+   */
+  template <typename Derived, typename RhsFunction>
+  void advance(Eigen::MatrixBase<Derived>& u,
+               RhsFunction&& calc_rhs) const noexcept {
+    using State = typename Derived::PlainObject;
+    const State u0 = u;
+
+    State v = u0 + dt_ * calc_rhs(u0);
+    v = 0.75 * u0 + 0.25 * (v + dt_ * calc_rhs(v));
+    u = (1.0 / 3.0) * u0 + (2.0 / 3.0) * (v + dt_ * calc_rhs(v));
+  }
+
+ private:
+  /// Advance u by the three stages, each of which is an explicit Euler step
+  /// done by euler_step(v), keeping the initial state in u0
+  template <typename Derived, typename EulerStep, typename BoundaryFunction,
+            typename State>
+  void advance_stages(Eigen::MatrixBase<Derived>& u, EulerStep&& euler_step,
+                      BoundaryFunction&& apply_boundary, State& u0,
+                      State& v) const noexcept {
+    u0 = u;
+
+    v = u0;
+    euler_step(v);
+    apply_boundary(v);
+
+    euler_step(v);
+    v = 0.75 * u0 + 0.25 * v;
+    apply_boundary(v);
+
+    euler_step(v);
+    u = (1.0 / 3.0) * u0 + (2.0 / 3.0) * v;
+    apply_boundary(u);
+  }
+
+  ExplicitEulerScheme euler_;
+  double dt_;
+};
+
 }  // namespace cfd
 
 #endif  // CFD_TIME_INTEGRATION_SCHEMES_HPP
\ No newline at end of file
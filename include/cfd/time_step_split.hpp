@@ -0,0 +1,52 @@
+#ifndef CFD_TIME_STEP_SPLIT_HPP
+#define CFD_TIME_STEP_SPLIT_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+namespace cfd {
+
+/**
+ * @brief Split of a time interval into time steps
+ */
+struct TimeStepSplit {
+  int n_steps;       ///> Number of full time steps
+  double remainder;  ///> Length of the shortened last time step, or 0 if the
+                     ///> full time steps land on the end of the interval
+};
+
+/**
+ * @brief Split a time interval into full time steps and a shortened last one
+ *
+ * Ends within a tolerance of a full time step land on it, so that round-off
+ * does not cause a spurious tiny step.
+ *
+ * @param t_start Start of the interval
+ * @param t_end End of the interval
+ * @param dt Time step length
+ * @return std::optional<TimeStepSplit> Split of the interval, or none if the
+ * end is not finite, the interval is negative, or the number of full time
+ * steps does not fit in int
+ */
+inline std::optional<TimeStepSplit> split_time_steps(double t_start,
+                                                     double t_end,
+                                                     double dt) noexcept {
+  const double tolerance = 1e-9 * dt;
+  if (!std::isfinite(t_end) || !(dt > 0) || t_end < t_start - tolerance) {
+    return std::nullopt;
+  }
+  const double n = std::floor((t_end - t_start + tolerance) / dt);
+  // Also rejects NaN
+  if (!(n <= static_cast<double>(std::numeric_limits<int>::max()))) {
+    return std::nullopt;
+  }
+  const int n_steps = std::max(static_cast<int>(n), 0);
+  const double remainder = t_end - (t_start + n_steps * dt);
+  return TimeStepSplit{n_steps, remainder > tolerance ? remainder : 0.0};
+}
+
+}  // namespace cfd
+
+#endif  // CFD_TIME_STEP_SPLIT_HPP
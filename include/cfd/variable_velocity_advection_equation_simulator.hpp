@@ -0,0 +1,128 @@
+#ifndef CFD_VARIABLE_VELOCITY_ADVECTION_EQUATION_SIMULATOR_HPP
+#define CFD_VARIABLE_VELOCITY_ADVECTION_EQUATION_SIMULATOR_HPP
+
+#include <Eigen/Core>
+#include <cstddef>
+
+#include "cfd/boundary_conditions.hpp"
+#include "cfd/periodic_boundary.hpp"
+#include "cfd/problem_parameters.hpp"
+#include "cfd/velocity_field.hpp"
+
+namespace cfd {
+
+/**
+ * @brief Simulator of the scalar advection equation in conservation form with
+ * a spatially varying and optionally time-dependent velocity
+ *
+ * @f[
+ * \frac{\partial u}{\partial t} + \frac{\partial (c u)}{\partial x} = 0
+ * @f]
+ *
+ * The Riemann solver and the spacial reconstructor read face velocities and
+ * local Courant numbers from a VelocityField, which is refreshed at the time of
+ * each stage of the time integrator and only re-evaluated when it depends on
+ * time. The time integrator provides the stage times as stage_times.
+ */
+template <typename RiemannSolver, typename SpacialReconstructor,
+          typename TimeIntegrator, typename Boundary = PeriodicBoundary>
+class VariableVelocityAdvectionEquationSimulator {
+ public:
+  /**
+   * @brief Construct a new Variable Velocity Advection Equation Simulator
+   * object
+   *
+   * @param params Problem parameters. The scalar velocity is not used.
+   * @param velocity Velocity field
+   */
+  VariableVelocityAdvectionEquationSimulator(const ProblemParameters& params,
+                                             const VelocityField& velocity)
+      : n_boundary_cells_{params.n_boundary_cells},
+        n_domain_cells_{params.n_domain_cells},
+        n_timesteps_{params.n_timesteps},
+        dt_{params.dt},
+        velocity_{velocity},
+        solver_{params},
+        reconstructor_{params},
+        integrator_{params},
+        boundary_{params} {}
+
+  /**
+   * @brief Construct a new Variable Velocity Advection Equation Simulator
+   * object
+   *
+   * @param params Problem parameters. The scalar velocity is not used.
+   * @param velocity Velocity field
+   * @param boundary Boundary conditions
+   */
+  VariableVelocityAdvectionEquationSimulator(const ProblemParameters& params,
+                                             const VelocityField& velocity,
+                                             const Boundary& boundary)
+      : n_boundary_cells_{params.n_boundary_cells},
+        n_domain_cells_{params.n_domain_cells},
+        n_timesteps_{params.n_timesteps},
+        dt_{params.dt},
+        velocity_{velocity},
+        solver_{params},
+        reconstructor_{params},
+        integrator_{params},
+        boundary_{boundary} {}
+
+  /**
+   * @brief Run simulator
+   *
+   * @tparam Derived
+   * @param u0 Initial condition
+   * @return Eigen::VectorXd Values at the end of time steps.
+   */
+  template <typename Derived>
+  Eigen::VectorXd run(const Eigen::MatrixBase<Derived>& u0) const {
+    using Eigen::seqN;
+    using Eigen::VectorXd;
+
+    VelocityField velocity = velocity_;
+    VectorXd u(this->n_total_cells());
+    u(seqN(n_boundary_cells_, n_domain_cells_)) = u0;
+    boundary_.apply(u);
+
+    // Flux is evaluated once per stage in the order of stage_times.
+    const auto& stage_times = TimeIntegrator::stage_times;
+    double t = 0.0;
+    std::size_t stage = 0;
+    const auto calc_flux = [this, &velocity, &t, &stage,
+                            &stage_times](const auto& v) {
+      velocity.refresh(t + stage_times[stage] * dt_);
+      stage = (stage + 1) % stage_times.size();
+      const VectorXd ul = reconstructor_.calc_left(v, velocity);
+      const VectorXd ur = reconstructor_.calc_right(v, velocity);
+      return solver_.calc_flux(ul, ur, velocity);
+    };
+    const auto apply_boundary = [this](auto& v) { boundary_.apply(v); };
+
+    for (int i = 1; i <= n_timesteps_; ++i) {
+      t = (i - 1) * dt_;
+      integrator_.advance(u, calc_flux, apply_boundary);
+    }
+
+    return u(seqN(n_boundary_cells_, n_domain_cells_));
+  }
+
+ private:
+  int n_total_cells() const noexcept {
+    return n_boundary_cells_ * 2 + n_domain_cells_;
+  }
+
+  int n_boundary_cells_;
+  int n_domain_cells_;
+  int n_timesteps_;
+  double dt_;
+  VelocityField velocity_;
+  RiemannSolver solver_;
+  SpacialReconstructor reconstructor_;
+  TimeIntegrator integrator_;
+  Boundary boundary_;
+};
+
+}  // namespace cfd
+
+#endif  // CFD_VARIABLE_VELOCITY_ADVECTION_EQUATION_SIMULATOR_HPP
@@ -0,0 +1,128 @@
+#ifndef CFD_VELOCITY_FIELD_HPP
+#define CFD_VELOCITY_FIELD_HPP
+
+#include <Eigen/Core>
+#include <cassert>
+#include <functional>
+#include <utility>
+
+#include "cfd/problem_parameters.hpp"
+
+namespace cfd {
+
+/**
+ * @brief Spatially varying and optionally time-dependent velocity field
+ *
+ * Velocities are cached at the n_domain_cells + 1 cell faces together with
+ * their absolute values and the local Courant numbers
+ * @f$ \nu_{j+1/2} = c_{j+1/2} \Delta t / \Delta x @f$. The cache is refreshed
+ * only when the field changes: a velocity vector is cached once, a function
+ * of @f$ x @f$ is evaluated once, and a function of @f$ (x, t) @f$ is
+ * evaluated once per call of refresh() with a new time.
+ */
+class VelocityField {
+ public:
+  using Function = std::function<double(double x, double t)>;
+
+  /**
+   * @brief Construct a new Velocity Field object from face velocities
+   *
+   * @param params Problem parameters
+   * @param face_velocities Velocities at the n_domain_cells + 1 cell faces
+   */
+  VelocityField(const ProblemParameters& params,
+                const Eigen::VectorXd& face_velocities)
+      : dt_{params.dt}, dx_{params.dx}, n_faces_{params.n_domain_cells + 1} {
+    this->set(face_velocities);
+  }
+
+  /**
+   * @brief Construct a new Velocity Field object from a function
+   *
+   * @param params Problem parameters
+   * @param x_faces Coordinates of the n_domain_cells + 1 cell faces
+   * @param function Velocity @f$ c(x, t) @f$
+   * @param time_dependent Whether the function depends on time
+   */
+  VelocityField(const ProblemParameters& params, Eigen::VectorXd x_faces,
+                Function function, bool time_dependent)
+      : dt_{params.dt},
+        dx_{params.dx},
+        n_faces_{params.n_domain_cells + 1},
+        x_faces_{std::move(x_faces)},
+        function_{std::move(function)},
+        time_dependent_{time_dependent} {
+    assert(x_faces_.size() == n_faces_);
+    assert(function_);
+    this->evaluate(0.0);
+  }
+
+  /**
+   * @brief Replace face velocities
+   *
+   * @param face_velocities Velocities at the n_domain_cells + 1 cell faces
+   */
+  void set(const Eigen::VectorXd& face_velocities) {
+    assert(face_velocities.size() == n_faces_);
+    function_ = nullptr;
+    time_dependent_ = false;
+    velocity_ = face_velocities.array();
+    this->update_derived();
+  }
+
+  /**
+   * @brief Refresh cached velocities at time @f$ t @f$
+   *
+   * This is a no-op unless the field is time-dependent and @f$ t @f$ differs
+   * from the time of the cached velocities.
+   *
+   * @param t Time
+   */
+  void refresh(double t) {
+    if (time_dependent_ && t != time_) {
+      this->evaluate(t);
+    }
+  }
+
+  bool time_dependent() const noexcept { return time_dependent_; }
+
+  /// Velocities at cell faces
+  const Eigen::ArrayXd& velocity() const noexcept { return velocity_; }
+
+  /// Absolute values of velocities at cell faces
+  const Eigen::ArrayXd& abs_velocity() const noexcept { return abs_velocity_; }
+
+  /// Local Courant numbers at cell faces
+  const Eigen::ArrayXd& courant() const noexcept { return courant_; }
+
+  /// Maximum absolute value of local Courant numbers
+  double max_courant() const noexcept { return courant_.abs().maxCoeff(); }
+
+ private:
+  void evaluate(double t) {
+    velocity_ = x_faces_.array().unaryExpr(
+        [&f = function_, t](double x) { return f(x, t); });
+    time_ = t;
+    this->update_derived();
+  }
+
+  void update_derived() {
+    abs_velocity_ = velocity_.abs();
+    courant_ = velocity_ * dt_ / dx_;
+  }
+
+  double dt_;
+  double dx_;
+  Eigen::Index n_faces_;
+  double time_ = 0.0;
+  Eigen::VectorXd x_faces_;
+  Function function_;
+  bool time_dependent_ = false;
+  Eigen::ArrayXd velocity_;
+  Eigen::ArrayXd abs_velocity_;
+  Eigen::ArrayXd courant_;
+};
+
+}  // namespace cfd
+
+#endif  // CFD_VELOCITY_FIELD_HPP
@@ -0,0 +1,20 @@
+#ifndef CFD_VERSION_HPP
+#define CFD_VERSION_HPP
+
+// Defined by the cfd target from the project version in CMakeLists.txt
+#ifndef CFD_VERSION
+#error "CFD_VERSION must be defined as the project version."
+#endif
+
+namespace cfd {
+
+/**
+ * @brief Returns the version of the library
+ *
+ * @return const char* Version string
+ */
+constexpr const char* library_version() noexcept { return CFD_VERSION; }
+
+}  // namespace cfd
+
+#endif  // CFD_VERSION_HPP
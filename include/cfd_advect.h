@@ -0,0 +1,115 @@
+#ifndef CFD_ADVECT_H
+#define CFD_ADVECT_H
+
+/*
+ * C API of the 1-D scalar advection equation simulators.
+ *
+ * The state is a caller-owned array of (n_domain_cells + 2 * n_boundary_cells)
+ * doubles. Domain cells start at offset n_boundary_cells, and boundary cells
+ * are overwritten by the library. The state is advanced in place without being
+ * copied in or out.
+ */
+
+#if defined(_WIN32)
+#if defined(CFD_ADVECT_BUILDING)
+#define CFD_ADVECT_API __declspec(dllexport)
+#else
+#define CFD_ADVECT_API __declspec(dllimport)
+#endif
+#else
+#define CFD_ADVECT_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Version of this API. It is incremented on incompatible changes. */
+#define CFD_ADVECT_API_VERSION 1
+
+/** Problem parameters */
+typedef struct cfd_advect_params {
+  int n_domain_cells;   /**< Number of domain cells */
+  int n_boundary_cells; /**< Number of boundary cells on one side */
+  double dt;            /**< Time step length */
+  double dx;            /**< Cell length */
+  double velocity;      /**< Velocity */
+  double eps;           /**< Entropy fix parameter (unused by Roe solver) */
+} cfd_advect_params;
+
+/** Spacial reconstruction schemes, all with the Roe-Riemann solver */
+typedef enum cfd_advect_scheme {
+  CFD_ADVECT_FIRST_ORDER_UPWIND = 0,
+  CFD_ADVECT_LAX_WENDROFF = 1,
+  CFD_ADVECT_BEAM_WARMING = 2,
+  CFD_ADVECT_FROMM = 3,
+  CFD_ADVECT_TVD_MINMOD = 4,
+  CFD_ADVECT_TVD_SUPERBEE = 5,
+  CFD_ADVECT_TVD_VAN_LEER = 6,
+  CFD_ADVECT_TVD_VAN_ALBADA = 7,
+  CFD_ADVECT_WENO5_JS = 8,
+  CFD_ADVECT_WENO5_Z = 9
+} cfd_advect_scheme;
+
+typedef enum cfd_advect_status {
+  CFD_ADVECT_OK = 0,
+  CFD_ADVECT_INVALID_ARGUMENT = 1,
+  CFD_ADVECT_UNKNOWN_SCHEME = 2,
+  CFD_ADVECT_OUT_OF_MEMORY = 3
+} cfd_advect_status;
+
+/** Opaque simulator handle */
+typedef struct cfd_advect_simulator cfd_advect_simulator;
+
+/** Returns the library version as "major.minor.patch". */
+CFD_ADVECT_API const char* cfd_advect_version(void);
+
+/** Returns a static description of a status code. */
+CFD_ADVECT_API const char* cfd_advect_status_string(cfd_advect_status status);
+
+/**
+ * Creates a simulator. On success, *simulator must be released by
+ * cfd_advect_destroy(). Returns CFD_ADVECT_INVALID_ARGUMENT unless dt and dx
+ * are positive and finite, velocity and eps are finite, and the number of
+ * total cells fits in int.
+ */
+CFD_ADVECT_API cfd_advect_status
+cfd_advect_create(const cfd_advect_params* params, cfd_advect_scheme scheme,
+                  cfd_advect_simulator** simulator);
+
+/** Destroys a simulator. Passing NULL is allowed. */
+CFD_ADVECT_API void cfd_advect_destroy(cfd_advect_simulator* simulator);
+
+/** Returns the required length of a state array. */
+CFD_ADVECT_API int cfd_advect_n_total_cells(
+    const cfd_advect_simulator* simulator);
+
+/** Returns the offset of the first domain cell in a state array. */
+CFD_ADVECT_API int cfd_advect_domain_offset(
+    const cfd_advect_simulator* simulator);
+
+/** Returns the current time of a simulator, which starts from zero. */
+CFD_ADVECT_API double cfd_advect_time(const cfd_advect_simulator* simulator);
+
+/**
+ * Advances a state in place by n_steps time steps. Returns
+ * CFD_ADVECT_OUT_OF_MEMORY if memory cannot be allocated, in which case the
+ * state is undefined and the time of the simulator is not advanced.
+ */
+CFD_ADVECT_API cfd_advect_status cfd_advect_step(
+    cfd_advect_simulator* simulator, double* u, int n_steps);
+
+/**
+ * Advances a state in place up to time t_end. The last step is shortened to
+ * land on t_end exactly. Returns CFD_ADVECT_OUT_OF_MEMORY if memory cannot
+ * be allocated, in which case the state is undefined and the time of the
+ * simulator is not advanced.
+ */
+CFD_ADVECT_API cfd_advect_status cfd_advect_advance_to(
+    cfd_advect_simulator* simulator, double* u, double t_end);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CFD_ADVECT_H */
@@ -1,4 +1,4 @@
-$simulators = "first_order_upwind", "lax_wendroff", "beam_warming", "fromm", "tvd_minmod", "tvd_superbee", "tvd_van_leer", "tvd_van_albada"
+$simulators = "first_order_upwind", "lax_wendroff", "beam_warming", "fromm", "tvd_minmod", "tvd_superbee", "tvd_van_leer", "tvd_van_albada", "weno5_js", "weno5_z", "discontinuous_galerkin", "tvd_minmod_parallel", "tvd_minmod_inflow_outflow", "tvd_minmod_mapped", "tvd_minmod_parareal", "tvd_minmod_active_region", "tvd_minmod_out_of_core", "hybrid_minmod", "tvd_minmod_cached", "tvd_multi_limiter", "tvd_minmod_frames", "tvd_minmod_auto_tuned", "tvd_minmod_2d", "linear_acoustics", "variable_velocity_tvd_minmod", "tvd_minmod_arena"
 foreach ($simulator in $simulators) {
     if (-not (Test-Path ".\build\${simulator}.exe")) {
         throw ".\build\${simulator}.exe not found!"
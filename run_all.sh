@@ -6,4 +6,22 @@
 ./build/tvd_minmod
 ./build/tvd_superbee
 ./build/tvd_van_leer
-./build/tvd_van_albada
\ No newline at end of file
+./build/tvd_van_albada
+./build/weno5_js
+./build/weno5_z
+./build/discontinuous_galerkin
+./build/tvd_minmod_parallel
+./build/tvd_minmod_inflow_outflow
+./build/tvd_minmod_mapped
+./build/tvd_minmod_parareal
+./build/tvd_minmod_active_region
+./build/tvd_minmod_out_of_core
+./build/hybrid_minmod
+./build/tvd_minmod_cached
+./build/tvd_multi_limiter
+./build/tvd_minmod_frames
+./build/tvd_minmod_auto_tuned
+./build/tvd_minmod_2d
+./build/linear_acoustics
+./build/variable_velocity_tvd_minmod
+./build/tvd_minmod_arena
\ No newline at end of file
@@ -0,0 +1,250 @@
+#include "cfd_advect.h"
+
+#include <Eigen/Core>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <new>
+
+#include "cfd/problem_parameters.hpp"
+#include "cfd/riemann_solvers.hpp"
+#include "cfd/scalar_advection_equation_simulator.hpp"
+#include "cfd/slope_limiters.hpp"
+#include "cfd/spacial_reconstruction_schemes.hpp"
+#include "cfd/state_arena.hpp"
+#include "cfd/time_integration_schemes.hpp"
+#include "cfd/time_step_split.hpp"
+#include "cfd/version.hpp"
+
+using StateMap = Eigen::Map<Eigen::VectorXd>;
+
+struct cfd_advect_simulator {
+  explicit cfd_advect_simulator(const cfd::ProblemParameters& params)
+      : params{params} {}
+
+  virtual ~cfd_advect_simulator() = default;
+
+  /// Advance u by n_steps time steps of length params.dt
+  virtual void step(StateMap& u, int n_steps) const = 0;
+
+  /// Advance u by one time step of length dt
+  virtual void step_by(StateMap& u, double dt) const = 0;
+
+  cfd::ProblemParameters params;
+  double time = 0.0;
+};
+
+namespace {
+
+template <typename SpacialReconstructor,
+          typename TimeIntegrator = cfd::ExplicitEulerScheme>
+class SimulatorModel final : public cfd_advect_simulator {
+ public:
+  using Simulator =
+      cfd::ScalarAdvectionEquationSimulator<cfd::RoeRiemannSolver,
+                                            SpacialReconstructor,
+                                            TimeIntegrator>;
+
+  // Scratch buffers of the time integrator, face values on both sides, and
+  // scratch buffers of the reconstructor
+  static constexpr int n_buffers = TimeIntegrator::n_arena_buffers + 2 +
+                                   SpacialReconstructor::n_arena_buffers;
+
+  /// Reserve the scratch buffers of a time step up front, so that stepping
+  /// does not allocate
+  explicit SimulatorModel(const cfd::ProblemParameters& params)
+      : cfd_advect_simulator{params}, simulator_{params} {
+    arena_.reserve(Eigen::Index{n_buffers} * params.n_total_cells(),
+                   n_buffers);
+  }
+
+  void step(StateMap& u, int n_steps) const override {
+    simulator_.step(u, n_steps, arena_);
+  }
+
+  void step_by(StateMap& u, double dt) const override {
+    auto params = this->params;
+    params.dt = dt;
+    Simulator{params}.step(u, 1, arena_);
+  }
+
+ private:
+  Simulator simulator_;
+  mutable cfd::StateArena arena_;  ///> Scratch buffers of a time step
+};
+
+int required_boundary_cells(cfd_advect_scheme scheme) noexcept {
+  switch (scheme) {
+    case CFD_ADVECT_FIRST_ORDER_UPWIND:
+    case CFD_ADVECT_LAX_WENDROFF:
+      return 1;
+    case CFD_ADVECT_BEAM_WARMING:
+    case CFD_ADVECT_FROMM:
+    case CFD_ADVECT_TVD_MINMOD:
+    case CFD_ADVECT_TVD_SUPERBEE:
+    case CFD_ADVECT_TVD_VAN_LEER:
+    case CFD_ADVECT_TVD_VAN_ALBADA:
+      return 2;
+    case CFD_ADVECT_WENO5_JS:
+    case CFD_ADVECT_WENO5_Z:
+      return 3;
+  }
+  return -1;
+}
+
+std::unique_ptr<cfd_advect_simulator> make_simulator(
+    const cfd::ProblemParameters& params, cfd_advect_scheme scheme) {
+  using namespace cfd;
+  switch (scheme) {
+    case CFD_ADVECT_FIRST_ORDER_UPWIND:
+      return std::make_unique<SimulatorModel<FirstOrderSpacialReconstructor>>(
+          params);
+    case CFD_ADVECT_LAX_WENDROFF:
+      return std::make_unique<SimulatorModel<LaxWendroffSpacialReconstructor>>(
+          params);
+    case CFD_ADVECT_BEAM_WARMING:
+      return std::make_unique<SimulatorModel<BeamWarmingSpacialReconstructor>>(
+          params);
+    case CFD_ADVECT_FROMM:
+      return std::make_unique<SimulatorModel<FrommSpacialReconstructor>>(
+          params);
+    case CFD_ADVECT_TVD_MINMOD:
+      return std::make_unique<
+          SimulatorModel<TvdSpacialReconstructor<MinmodLimiter>>>(params);
+    case CFD_ADVECT_TVD_SUPERBEE:
+      return std::make_unique<
+          SimulatorModel<TvdSpacialReconstructor<SuperbeeLimiter>>>(params);
+    case CFD_ADVECT_TVD_VAN_LEER:
+      return std::make_unique<
+          SimulatorModel<TvdSpacialReconstructor<VanLeerLimiter>>>(params);
+    case CFD_ADVECT_TVD_VAN_ALBADA:
+      return std::make_unique<
+          SimulatorModel<TvdSpacialReconstructor<VanAlbadaLimiter>>>(params);
+    case CFD_ADVECT_WENO5_JS:
+      return std::make_unique<
+          SimulatorModel<Weno5SpacialReconstructor<WenoJsWeights>,
+                         SspRungeKutta3Scheme>>(params);
+    case CFD_ADVECT_WENO5_Z:
+      return std::make_unique<
+          SimulatorModel<Weno5SpacialReconstructor<WenoZWeights>,
+                         SspRungeKutta3Scheme>>(params);
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+extern "C" {
+
+const char* cfd_advect_version(void) { return cfd::library_version(); }
+
+const char* cfd_advect_status_string(cfd_advect_status status) {
+  switch (status) {
+    case CFD_ADVECT_OK:
+      return "success";
+    case CFD_ADVECT_INVALID_ARGUMENT:
+      return "invalid argument";
+    case CFD_ADVECT_UNKNOWN_SCHEME:
+      return "unknown scheme";
+    case CFD_ADVECT_OUT_OF_MEMORY:
+      return "out of memory";
+  }
+  return "unknown status";
+}
+
+cfd_advect_status cfd_advect_create(const cfd_advect_params* params,
+                                    cfd_advect_scheme scheme,
+                                    cfd_advect_simulator** simulator) {
+  if (params == nullptr || simulator == nullptr) {
+    return CFD_ADVECT_INVALID_ARGUMENT;
+  }
+  *simulator = nullptr;
+  const int n_required = required_boundary_cells(scheme);
+  if (n_required < 0) {
+    return CFD_ADVECT_UNKNOWN_SCHEME;
+  }
+  if (params->n_domain_cells < 1 || params->n_boundary_cells < n_required ||
+      params->n_boundary_cells > params->n_domain_cells) {
+    return CFD_ADVECT_INVALID_ARGUMENT;
+  }
+  // The number of total cells must fit in int.
+  if (2LL * params->n_boundary_cells + params->n_domain_cells >
+      std::numeric_limits<int>::max()) {
+    return CFD_ADVECT_INVALID_ARGUMENT;
+  }
+  if (!std::isfinite(params->dt) || !(params->dt > 0) ||
+      !std::isfinite(params->dx) || !(params->dx > 0) ||
+      !std::isfinite(params->velocity) || !std::isfinite(params->eps)) {
+    return CFD_ADVECT_INVALID_ARGUMENT;
+  }
+
+  const cfd::ProblemParameters problem{0,
+                                       params->n_domain_cells,
+                                       params->n_boundary_cells,
+                                       params->dt,
+                                       params->dx,
+                                       params->velocity,
+                                       params->eps};
+  try {
+    *simulator = make_simulator(problem, scheme).release();
+  } catch (const std::bad_alloc&) {
+    return CFD_ADVECT_OUT_OF_MEMORY;
+  }
+  return CFD_ADVECT_OK;
+}
+
+void cfd_advect_destroy(cfd_advect_simulator* simulator) { delete simulator; }
+
+int cfd_advect_n_total_cells(const cfd_advect_simulator* simulator) {
+  return simulator ? simulator->params.n_total_cells() : 0;
+}
+
+int cfd_advect_domain_offset(const cfd_advect_simulator* simulator) {
+  return simulator ? simulator->params.n_boundary_cells : 0;
+}
+
+double cfd_advect_time(const cfd_advect_simulator* simulator) {
+  return simulator ? simulator->time : 0.0;
+}
+
+cfd_advect_status cfd_advect_step(cfd_advect_simulator* simulator, double* u,
+                                  int n_steps) {
+  if (simulator == nullptr || u == nullptr || n_steps < 0) {
+    return CFD_ADVECT_INVALID_ARGUMENT;
+  }
+  try {
+    StateMap state(u, simulator->params.n_total_cells());
+    simulator->step(state, n_steps);
+  } catch (const std::bad_alloc&) {
+    return CFD_ADVECT_OUT_OF_MEMORY;
+  }
+  simulator->time += n_steps * simulator->params.dt;
+  return CFD_ADVECT_OK;
+}
+
+cfd_advect_status cfd_advect_advance_to(cfd_advect_simulator* simulator,
+                                        double* u, double t_end) {
+  if (simulator == nullptr || u == nullptr) {
+    return CFD_ADVECT_INVALID_ARGUMENT;
+  }
+  const double t_start = simulator->time;
+  const auto split =
+      cfd::split_time_steps(t_start, t_end, simulator->params.dt);
+  if (!split) {
+    return CFD_ADVECT_INVALID_ARGUMENT;
+  }
+
+  try {
+    StateMap state(u, simulator->params.n_total_cells());
+    simulator->step(state, split->n_steps);
+    if (split->remainder > 0) {
+      simulator->step_by(state, split->remainder);
+    }
+  } catch (const std::bad_alloc&) {
+    return CFD_ADVECT_OUT_OF_MEMORY;
+  }
+  simulator->time = std::fmax(t_end, t_start);
+  return CFD_ADVECT_OK;
+}
+
+}  // extern "C"
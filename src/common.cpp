@@ -1,5 +1,6 @@
 #include "common.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 namespace cfd {
@@ -10,13 +11,22 @@ constexpr double x_left() noexcept { return -1.0; }
 
 constexpr double x_right() noexcept { return 1.0; }
 
+constexpr double y_bottom() noexcept { return -1.0; }
+
+constexpr double y_top() noexcept { return 1.0; }
+
+Eigen::VectorXd make_cell_centers(int n, double left, double right) noexcept {
+  using Eigen::VectorXd;
+  const VectorXd x = VectorXd::LinSpaced(n + 1, left, right);
+  return 0.5 * (x.head(n) + x.tail(n));
+}
+
 }  // namespace
 
-ProblemParameters make_params() noexcept {
+ProblemParameters make_params(int n_boundary_cells) noexcept {
   const auto xl = x_left();
   const auto xr = x_right();
   const int n_domain_cells = 100;
-  const int n_boundary_cells = 2;
   const auto dx = (xr - xl) / static_cast<double>(n_domain_cells);
   const auto dt = 0.2 * dx;
   const int n_timesteps = 500;
@@ -27,10 +37,12 @@ ProblemParameters make_params() noexcept {
 }
 
 Eigen::VectorXd make_x(const ProblemParameters& params) noexcept {
-  using Eigen::VectorXd;
-  const auto nd = params.n_domain_cells;
-  const VectorXd x = VectorXd::LinSpaced(nd + 1, x_left(), x_right());
-  return 0.5 * (x.head(nd) + x.tail(nd));
+  return make_cell_centers(params.n_domain_cells, x_left(), x_right());
+}
+
+Eigen::VectorXd make_x_faces(const ProblemParameters& params) noexcept {
+  return Eigen::VectorXd::LinSpaced(params.n_domain_cells + 1, x_left(),
+                                    x_right());
 }
 
 Eigen::VectorXd make_sine_wave(const Eigen::VectorXd& x) noexcept {
@@ -44,4 +56,47 @@ Eigen::VectorXd make_pulse_wave(const Eigen::VectorXd& x) noexcept {
   return u;
 }
 
+ProblemParameters2d make_params_2d() noexcept {
+  const auto xl = x_left();
+  const auto xr = x_right();
+  const auto yb = y_bottom();
+  const auto yt = y_top();
+  const int n_domain_cells_x = 100;
+  const int n_domain_cells_y = 100;
+  const int n_boundary_cells = 2;
+  const auto dx = (xr - xl) / static_cast<double>(n_domain_cells_x);
+  const auto dy = (yt - yb) / static_cast<double>(n_domain_cells_y);
+  const auto dt = 0.2 * std::min(dx, dy);
+  const int n_timesteps = 500;
+  const double velocity_x = 1.0;
+  const double velocity_y = 1.0;
+  const double eps = 0.25;
+
+  return {n_timesteps, n_domain_cells_x, n_domain_cells_y, n_boundary_cells,
+          dt,          dx,               dy,               velocity_x,
+          velocity_y,  eps};
+}
+
+Eigen::VectorXd make_x(const ProblemParameters2d& params) noexcept {
+  return make_cell_centers(params.n_domain_cells_x, x_left(), x_right());
+}
+
+Eigen::VectorXd make_y(const ProblemParameters2d& params) noexcept {
+  return make_cell_centers(params.n_domain_cells_y, y_bottom(), y_top());
+}
+
+Eigen::MatrixXd make_sine_wave(const Eigen::VectorXd& x,
+                               const Eigen::VectorXd& y) noexcept {
+  const Eigen::VectorXd ux = make_sine_wave(x);
+  const Eigen::VectorXd uy = make_sine_wave(y);
+  return ux * uy.transpose();
+}
+
+Eigen::MatrixXd make_pulse_wave(const Eigen::VectorXd& x,
+                                const Eigen::VectorXd& y) noexcept {
+  const Eigen::VectorXd ux = make_pulse_wave(x);
+  const Eigen::VectorXd uy = make_pulse_wave(y);
+  return ux * uy.transpose();
+}
+
 }  // namespace cfd
@@ -4,17 +4,32 @@
 #include <Eigen/Core>
 
 #include "cfd/problem_parameters.hpp"
+#include "cfd/problem_parameters_2d.hpp"
 
 namespace cfd {
 
-ProblemParameters make_params() noexcept;
+ProblemParameters make_params(int n_boundary_cells = 2) noexcept;
 
 Eigen::VectorXd make_x(const ProblemParameters& params) noexcept;
 
+Eigen::VectorXd make_x_faces(const ProblemParameters& params) noexcept;
+
 Eigen::VectorXd make_sine_wave(const Eigen::VectorXd& x) noexcept;
 
 Eigen::VectorXd make_pulse_wave(const Eigen::VectorXd& x) noexcept;
 
+ProblemParameters2d make_params_2d() noexcept;
+
+Eigen::VectorXd make_x(const ProblemParameters2d& params) noexcept;
+
+Eigen::VectorXd make_y(const ProblemParameters2d& params) noexcept;
+
+Eigen::MatrixXd make_sine_wave(const Eigen::VectorXd& x,
+                               const Eigen::VectorXd& y) noexcept;
+
+Eigen::MatrixXd make_pulse_wave(const Eigen::VectorXd& x,
+                                const Eigen::VectorXd& y) noexcept;
+
 }  // namespace cfd
 
 #endif  // CFD_COMMON_HPP
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include <fmt/core.h>
+
+#include <Eigen/Core>
+
+#include "cfd/cfd.hpp"
+#include "common.hpp"
+
+namespace cfd {
+
+template <int Order>
+using Simulator = DiscontinuousGalerkinSimulator<RoeRiemannSolver, Order>;
+
+template <int Order>
+void run_dg(const ProblemParameters& params) {
+  namespace fs = std::filesystem;
+  using Eigen::VectorXd;
+
+  const auto simulator = Simulator<Order>{params};
+  const VectorXd x = simulator.nodes(make_x_faces(params)(0));
+  const auto directory =
+      fs::path(fmt::format("result/discontinuous_galerkin/p{}", Order));
+
+  // Sine wave
+  {
+    const VectorXd u0 = make_sine_wave(x);
+    const VectorXd uN = simulator.run(u0);
+    const auto writer = TextFileWriter{directory / "sine"};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+  }
+
+  // Pulse wave
+  {
+    const VectorXd u0 = make_pulse_wave(x);
+    const VectorXd uN = simulator.run(u0);
+    const auto writer = TextFileWriter{directory / "pulse"};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+  }
+}
+
+}  // namespace cfd
+
+int main(int argc, char** argv) {
+  // 20 elements of 5 cells long, so that the time step length satisfies
+  // |a| dt <= 0.5 dx / (2 Order + 1) up to Order = 4.
+  auto params = cfd::make_params();
+  params.n_domain_cells = 20;
+  params.dx *= 5;
+
+  cfd::run_dg<1>(params);
+  cfd::run_dg<2>(params);
+  cfd::run_dg<3>(params);
+  cfd::run_dg<4>(params);
+}
\ No newline at end of file
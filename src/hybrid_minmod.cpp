@@ -0,0 +1,62 @@
+#include <fmt/core.h>
+
+#include <Eigen/Core>
+
+#include "cfd/cfd.hpp"
+#include "common.hpp"
+
+namespace cfd {
+
+using Simulator =
+    ScalarAdvectionEquationSimulator<RoeRiemannSolver,
+                                     HybridSpacialReconstructor<MinmodLimiter>,
+                                     ExplicitEulerScheme>;
+
+/// Run simulator, and collect the numbers of faces of every time step
+Eigen::VectorXd run(const ProblemParameters& params, const Eigen::VectorXd& u0,
+                    HybridStatistics& statistics) {
+  const auto simulator = Simulator{params};
+  const Eigen::VectorXd uN = simulator.run(u0);
+  statistics = simulator.reconstructor().statistics();
+  return uN;
+}
+
+void print_statistics(const HybridStatistics& statistics) {
+  fmt::print("Limited faces: {} of {} ({:.1f}%)\n", statistics.limited_faces,
+             statistics.faces, 100.0 * statistics.limited_fraction());
+}
+
+}  // namespace cfd
+
+int main(int argc, char** argv) {
+  using Eigen::VectorXd;
+  namespace fs = std::filesystem;
+
+  const auto params = cfd::make_params();
+  const VectorXd x = cfd::make_x(params);
+  cfd::HybridStatistics statistics;
+
+  // Sine wave
+  {
+    const VectorXd u0 = cfd::make_sine_wave(x);
+    const VectorXd uN = cfd::run(params, u0, statistics);
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/hybrid_minmod/sine")};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+    cfd::print_statistics(statistics);
+  }
+
+  // Pulse wave
+  {
+    const VectorXd u0 = cfd::make_pulse_wave(x);
+    const VectorXd uN = cfd::run(params, u0, statistics);
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/hybrid_minmod/pulse")};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+    cfd::print_statistics(statistics);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include <Eigen/Core>
+
+#include "cfd/cfd.hpp"
+#include "common.hpp"
+
+namespace cfd {
+
+/**
+ * Linear acoustics with pressure p and velocity v:
+ *
+ *   p_t + K v_x = 0
+ *   v_t + (1 / rho) p_x = 0
+ *
+ * with bulk modulus K = 1 and density rho = 1.
+ */
+using Simulator =
+    LinearSystemSimulator<2, TvdSpacialReconstructor<MinmodLimiter>,
+                          AosLayout>;
+
+Eigen::Matrix2d make_acoustics_matrix() noexcept {
+  const double bulk_modulus = 1.0;
+  const double density = 1.0;
+  Eigen::Matrix2d a;
+  a << 0.0, bulk_modulus, 1.0 / density, 0.0;
+  return a;
+}
+
+}  // namespace cfd
+
+int main(int argc, char** argv) {
+  using Eigen::Matrix2Xd;
+  using Eigen::VectorXd;
+  namespace fs = std::filesystem;
+
+  const auto params = cfd::make_params();
+  const VectorXd x = cfd::make_x(params);
+  const auto simulator = cfd::Simulator{params, cfd::make_acoustics_matrix()};
+
+  // Sine wave
+  {
+    Matrix2Xd u0 = Matrix2Xd::Zero(2, x.size());
+    u0.row(0) = cfd::make_sine_wave(x).transpose();
+    const Matrix2Xd uN = simulator.run(u0);
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/linear_acoustics/sine")};
+    writer.write(x, "x.txt");
+    writer.write(u0.transpose(), "u0.txt");
+    writer.write(uN.transpose(), "u500.txt");
+  }
+
+  // Pulse wave
+  {
+    Matrix2Xd u0 = Matrix2Xd::Zero(2, x.size());
+    u0.row(0) = cfd::make_pulse_wave(x).transpose();
+    const Matrix2Xd uN = simulator.run(u0);
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/linear_acoustics/pulse")};
+    writer.write(x, "x.txt");
+    writer.write(u0.transpose(), "u0.txt");
+    writer.write(uN.transpose(), "u500.txt");
+  }
+}
\ No newline at end of file
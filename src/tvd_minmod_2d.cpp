@@ -0,0 +1,48 @@
+#include <Eigen/Core>
+
+#include "cfd/cfd.hpp"
+#include "common.hpp"
+
+namespace cfd {
+
+using Simulator =
+    ScalarAdvectionEquationSimulator2d<RoeRiemannSolver,
+                                       TvdSpacialReconstructor<MinmodLimiter>,
+                                       ExplicitEulerScheme>;
+
+}
+
+int main(int argc, char** argv) {
+  using Eigen::MatrixXd;
+  using Eigen::VectorXd;
+  namespace fs = std::filesystem;
+
+  const auto params = cfd::make_params_2d();
+  const VectorXd x = cfd::make_x(params);
+  const VectorXd y = cfd::make_y(params);
+  const auto simulator = cfd::Simulator{params};
+
+  // Sine wave
+  {
+    const MatrixXd u0 = cfd::make_sine_wave(x, y);
+    const MatrixXd uN = simulator.run(u0);
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/tvd_minmod_2d/sine")};
+    writer.write(x, "x.txt");
+    writer.write(y, "y.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+  }
+
+  // Pulse wave
+  {
+    const MatrixXd u0 = cfd::make_pulse_wave(x, y);
+    const MatrixXd uN = simulator.run(u0);
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/tvd_minmod_2d/pulse")};
+    writer.write(x, "x.txt");
+    writer.write(y, "y.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+  }
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include <fmt/core.h>
+
+#include <Eigen/Core>
+#include <chrono>
+
+#include "cfd/cfd.hpp"
+#include "common.hpp"
+
+namespace cfd {
+
+using Simulator =
+    ActiveRegionSimulator<RoeRiemannSolver,
+                          TvdSpacialReconstructor<MinmodLimiter>,
+                          ExplicitEulerScheme>;
+
+using FullSimulator =
+    ScalarAdvectionEquationSimulator<RoeRiemannSolver,
+                                     TvdSpacialReconstructor<MinmodLimiter>,
+                                     ExplicitEulerScheme>;
+
+void print_report(const ActiveRegionReport& report) {
+  fmt::print("Cell updates: {} of {} ({:.1f}%)\n", report.cell_updates,
+             report.full_cell_updates, 100.0 * report.active_fraction());
+}
+
+/// Wall time of a function in seconds
+template <typename Function>
+double measure(Function&& f) {
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+/**
+ * Pulse covering 1% of a large domain, where most blocks stay quiescent,
+ * compared with full sweeps with and without a threshold
+ */
+void run_localized_pulse() {
+  auto params = make_params();
+  params.n_domain_cells = 2000;
+  params.dx = 2.0 / params.n_domain_cells;
+  params.dt = 0.2 * params.dx;
+  const Eigen::VectorXd u0 = make_pulse_wave(make_x(params));
+
+  Eigen::VectorXd u_full;
+  const double full_seconds =
+      measure([&] { u_full = FullSimulator{params}.run(u0); });
+  fmt::print("Localized pulse ({} cells), full sweeps: {:.6f} s\n",
+             params.n_domain_cells, full_seconds);
+  for (const double threshold : {0.0, 1e-6, 1e-3}) {
+    ActiveRegionOptions options;
+    options.threshold = threshold;
+    ActiveRegionReport report;
+    Eigen::VectorXd uN;
+    const double seconds = measure(
+        [&] { uN = Simulator{params, options}.run(u0, &report); });
+    fmt::print("Threshold {:.0e}: {:.6f} s, difference: {:.3e}\n", threshold,
+               seconds, (uN - u_full).lpNorm<Eigen::Infinity>());
+    print_report(report);
+  }
+}
+
+}  // namespace cfd
+
+int main(int argc, char** argv) {
+  using Eigen::VectorXd;
+  namespace fs = std::filesystem;
+
+  const auto params = cfd::make_params();
+  const VectorXd x = cfd::make_x(params);
+  cfd::ActiveRegionOptions options;
+  options.block_size = 8;
+  const auto simulator = cfd::Simulator{params, options};
+  cfd::ActiveRegionReport report;
+
+  // Sine wave
+  {
+    const VectorXd u0 = cfd::make_sine_wave(x);
+    const VectorXd uN = simulator.run(u0, &report);
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/tvd_minmod_active_region/sine")};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+    cfd::print_report(report);
+  }
+
+  // Pulse wave
+  {
+    const VectorXd u0 = cfd::make_pulse_wave(x);
+    const VectorXd uN = simulator.run(u0, &report);
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/tvd_minmod_active_region/pulse")};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+    cfd::print_report(report);
+  }
+
+  cfd::run_localized_pulse();
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include <fmt/core.h>
+
+#include <Eigen/Core>
+#include <chrono>
+
+#include "cfd/cfd.hpp"
+#include "common.hpp"
+
+namespace cfd {
+
+using Simulator =
+    ScalarAdvectionEquationSimulator<RoeRiemannSolver,
+                                     TvdSpacialReconstructor<MinmodLimiter>,
+                                     ExplicitEulerScheme>;
+
+/**
+ * @brief Run ensemble members of pulses shifted across the domain
+ *
+ * @tparam Run
+ * @param params Problem parameters
+ * @param n_members Number of ensemble members
+ * @param run Function running a member from its initial condition
+ * @return double Wall time of all members
+ */
+template <typename Run>
+double run_ensemble(const ProblemParameters& params, int n_members,
+                    Run&& run) {
+  const auto n = params.n_domain_cells;
+  const Eigen::VectorXd pulse = make_pulse_wave(make_x(params));
+  Eigen::VectorXd u0(n);
+  double checksum = 0.0;
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+  for (int m = 0; m < n_members; ++m) {
+    const auto shift = static_cast<Eigen::Index>(n) * m / n_members;
+    u0.head(n - shift) = pulse.tail(n - shift);
+    u0.tail(shift) = pulse.head(shift);
+    checksum += run(u0).sum();
+  }
+  const double seconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+  fmt::print("  Checksum: {:.12e}\n", checksum);
+  return seconds;
+}
+
+}  // namespace cfd
+
+int main(int argc, char** argv) {
+  using Eigen::VectorXd;
+  namespace fs = std::filesystem;
+
+  const auto params = cfd::make_params();
+  const VectorXd x = cfd::make_x(params);
+  const auto simulator = cfd::Simulator{params};
+  cfd::StateArena arena{cfd::HugePagePolicy::transparent};
+
+  // Sine wave
+  {
+    const VectorXd u0 = cfd::make_sine_wave(x);
+    const VectorXd uN = simulator.run(u0, arena);
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/tvd_minmod_arena/sine")};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+  }
+
+  // Pulse wave
+  {
+    const VectorXd u0 = cfd::make_pulse_wave(x);
+    const VectorXd uN = simulator.run(u0, arena);
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/tvd_minmod_arena/pulse")};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+  }
+
+  // Ensemble on a finer grid, where the arena is reused by all members and
+  // time steps instead of allocating face values and flux on the heap
+  {
+    auto ensemble_params = params;
+    ensemble_params.n_domain_cells = 1 << 16;
+    ensemble_params.dx = 2.0 / ensemble_params.n_domain_cells;
+    ensemble_params.dt = params.dt / params.dx * ensemble_params.dx;
+    ensemble_params.n_timesteps = 100;
+    const auto ensemble_simulator = cfd::Simulator{ensemble_params};
+    constexpr int n_members = 16;
+
+    fmt::print("Heap:\n");
+    const double heap_seconds = cfd::run_ensemble(
+        ensemble_params, n_members,
+        [&](const VectorXd& u0) { return ensemble_simulator.run(u0); });
+    fmt::print("Arena ({}huge pages):\n", arena.huge_pages() ? "" : "no ");
+    const double arena_seconds =
+        cfd::run_ensemble(ensemble_params, n_members, [&](const VectorXd& u0) {
+          return ensemble_simulator.run(u0, arena);
+        });
+    fmt::print("Wall time of {} members: heap {:.6f} s, arena {:.6f} s\n",
+               n_members, heap_seconds, arena_seconds);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include <fmt/core.h>
+
+#include <Eigen/Core>
+
+#include "cfd/cfd.hpp"
+#include "common.hpp"
+
+namespace cfd {
+
+using Tuner =
+    AutoTuner<RoeRiemannSolver, TvdSpacialReconstructor<MinmodLimiter>,
+              ExplicitEulerScheme>;
+
+void print_report(const AutoTunerReport& report) {
+  if (report.cached) {
+    fmt::print("Tuned variant (cached): {}\n", report.decision.describe());
+  } else {
+    fmt::print("Tuned variant: {} ({} candidates, {} rejected, {:.3f} s)\n",
+               report.decision.describe(), report.n_candidates,
+               report.n_rejected, report.tuning_seconds);
+  }
+}
+
+}  // namespace cfd
+
+int main(int argc, char** argv) {
+  using Eigen::VectorXd;
+  namespace fs = std::filesystem;
+
+  const auto params = cfd::make_params();
+  const VectorXd x = cfd::make_x(params);
+  // Decisions are stored per host, so runs after the first start instantly.
+  const auto tuner = cfd::Tuner{fs::path("result/tuning")};
+  cfd::AutoTunerReport report;
+
+  // Sine wave
+  {
+    const VectorXd u0 = cfd::make_sine_wave(x);
+    const VectorXd uN = tuner.run("tvd_minmod", params, u0, &report);
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/tvd_minmod_auto_tuned/sine")};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+    cfd::print_report(report);
+  }
+
+  // Pulse wave
+  {
+    const VectorXd u0 = cfd::make_pulse_wave(x);
+    const VectorXd uN = tuner.run("tvd_minmod", params, u0, &report);
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/tvd_minmod_auto_tuned/pulse")};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+    cfd::print_report(report);
+  }
+}
\ No newline at end of file
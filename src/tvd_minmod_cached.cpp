@@ -0,0 +1,49 @@
+#include <fmt/core.h>
+
+#include <Eigen/Core>
+
+#include "cfd/cfd.hpp"
+#include "common.hpp"
+
+namespace cfd {
+
+using Simulator =
+    ScalarAdvectionEquationSimulator<RoeRiemannSolver,
+                                     TvdSpacialReconstructor<MinmodLimiter>,
+                                     ExplicitEulerScheme>;
+
+void print_report(const ResultCacheReport& report, int n_timesteps) {
+  if (report.hit) {
+    fmt::print("u{}: cache hit\n", n_timesteps);
+  } else {
+    fmt::print("u{}: computed {} steps from step {}\n", n_timesteps,
+               report.computed_steps, report.warm_start_step);
+  }
+}
+
+}  // namespace cfd
+
+int main(int argc, char** argv) {
+  using Eigen::VectorXd;
+  namespace fs = std::filesystem;
+
+  auto params = cfd::make_params();
+  const VectorXd x = cfd::make_x(params);
+  const VectorXd u0 = cfd::make_pulse_wave(x);
+  const auto cache = cfd::ResultCache{fs::path("result/cache")};
+  const auto writer =
+      cfd::TextFileWriter{fs::path("result/tvd_minmod_cached/pulse")};
+  cfd::ResultCacheReport report;
+  writer.write(x, "x.txt");
+  writer.write(u0, "u0.txt");
+
+  // Later runs are warm-started from earlier ones, and all of them are cache
+  // hits when this program is run again.
+  for (const int n_timesteps : {100, 250, 500}) {
+    params.n_timesteps = n_timesteps;
+    const VectorXd uN =
+        cache.run<cfd::Simulator>("tvd_minmod", params, u0, &report);
+    writer.write(uN, fmt::format("u{}.txt", n_timesteps));
+    cfd::print_report(report, n_timesteps);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include <fmt/core.h>
+
+#include <Eigen/Core>
+
+#include "cfd/cfd.hpp"
+#include "common.hpp"
+
+namespace cfd {
+
+using Simulator =
+    ScalarAdvectionEquationSimulator<RoeRiemannSolver,
+                                     TvdSpacialReconstructor<MinmodLimiter>,
+                                     ExplicitEulerScheme>;
+
+}
+
+int main(int argc, char** argv) {
+  using Eigen::VectorXd;
+  namespace fs = std::filesystem;
+
+  const auto params = cfd::make_params();
+  const VectorXd x = cfd::make_x(params);
+
+  // Sine wave advanced up to given times
+  {
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/tvd_minmod_frames/sine")};
+    auto state = cfd::SimulationState<cfd::Simulator>{
+        params, cfd::make_sine_wave(x)};
+    writer.write(x, "x.txt");
+    writer.write(state.values(), "u0.txt");
+    for (const double t : {0.5, 1.0, 1.5, 2.0}) {
+      state.advance_to(t);
+      writer.write(state.values(), fmt::format("t{}.txt", t));
+    }
+  }
+
+  // Pulse wave pulled every 50 steps until its peak decays by 1%
+  {
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/tvd_minmod_frames/pulse")};
+    auto state = cfd::SimulationState<cfd::Simulator>{
+        params, cfd::make_pulse_wave(x)};
+    writer.write(x, "x.txt");
+    for (const auto& frame : state.frames(50)) {
+      writer.write(frame.values, fmt::format("u{}.txt", frame.step));
+      if (frame.values.maxCoeff() < 0.99) {
+        fmt::print("Peak decayed by 1% at step {} (t = {})\n", frame.step,
+                   frame.time);
+        break;
+      }
+    }
+  }
+}
\ No newline at end of file
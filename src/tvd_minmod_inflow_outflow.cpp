@@ -0,0 +1,48 @@
+#include <Eigen/Core>
+
+#include "cfd/cfd.hpp"
+#include "common.hpp"
+
+namespace cfd {
+
+using Simulator =
+    ScalarAdvectionEquationSimulator<RoeRiemannSolver,
+                                     TvdSpacialReconstructor<MinmodLimiter>,
+                                     ExplicitEulerScheme,
+                                     InflowOutflowBoundary>;
+
+}
+
+int main(int argc, char** argv) {
+  using Eigen::VectorXd;
+  namespace fs = std::filesystem;
+
+  const auto params = cfd::make_params();
+  const VectorXd x = cfd::make_x(params);
+
+  // Pulse wave leaving the domain with no inflow
+  {
+    const auto simulator =
+        cfd::Simulator{params, cfd::InflowOutflowBoundary{params, 0.0}};
+    const VectorXd u0 = cfd::make_pulse_wave(x);
+    const VectorXd uN = simulator.run(u0);
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/tvd_minmod_inflow_outflow/pulse")};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+  }
+
+  // Step entering the domain through the inflow boundary
+  {
+    const auto simulator =
+        cfd::Simulator{params, cfd::InflowOutflowBoundary{params, 1.0}};
+    const VectorXd u0 = VectorXd::Zero(params.n_domain_cells);
+    const VectorXd uN = simulator.run(u0);
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/tvd_minmod_inflow_outflow/step")};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+  }
+}
\ No newline at end of file
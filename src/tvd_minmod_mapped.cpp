@@ -0,0 +1,54 @@
+#include <fmt/core.h>
+
+#include <Eigen/Core>
+
+#include "cfd/cfd.hpp"
+#include "common.hpp"
+
+namespace cfd {
+
+using Simulator =
+    ScalarAdvectionEquationSimulator<RoeRiemannSolver,
+                                     TvdSpacialReconstructor<MinmodLimiter>,
+                                     ExplicitEulerScheme>;
+
+}
+
+// Usage: tvd_minmod_mapped [u0.bin x.bin]
+//
+// Without arguments, the pulse wave is written to binary files first, which
+// are then mapped as the initial condition.
+int main(int argc, char** argv) {
+  using Eigen::VectorXd;
+  namespace fs = std::filesystem;
+
+  const auto params = cfd::make_params();
+  const auto simulator = cfd::Simulator{params};
+  const auto directory = fs::path("result/tvd_minmod_mapped/pulse");
+
+  fs::path u0_path = directory / "u0.bin";
+  fs::path x_path = directory / "x.bin";
+  if (argc == 3) {
+    u0_path = argv[1];
+    x_path = argv[2];
+  } else if (argc == 1) {
+    const VectorXd x = cfd::make_x(params);
+    const auto writer = cfd::BinaryFileWriter{directory};
+    writer.write(x, "x.bin");
+    writer.write(cfd::make_pulse_wave(x), "u0.bin");
+  } else {
+    fmt::print(stderr, "Usage: {} [u0.bin x.bin]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  const auto u0 = cfd::BinaryFileReader{u0_path.parent_path()}.read(
+      u0_path.filename().string(), params);
+  const auto x = cfd::BinaryFileReader{x_path.parent_path()}.read(
+      x_path.filename().string(), params);
+  const VectorXd uN = simulator.run(u0.values());
+
+  const auto writer = cfd::TextFileWriter{directory};
+  writer.write(x.values(), "x.txt");
+  writer.write(u0.values(), "u0.txt");
+  writer.write(uN, "u500.txt");
+}
\ No newline at end of file
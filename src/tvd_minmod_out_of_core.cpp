@@ -0,0 +1,51 @@
+#include <fmt/core.h>
+
+#include <Eigen/Core>
+
+#include "cfd/cfd.hpp"
+#include "common.hpp"
+
+namespace cfd {
+
+using Simulator =
+    OutOfCoreSimulator<RoeRiemannSolver, TvdSpacialReconstructor<MinmodLimiter>,
+                       ExplicitEulerScheme>;
+
+void print_report(const OutOfCoreReport& report) {
+  fmt::print("Passes: {}, chunk loads: {}\n", report.passes,
+             report.chunk_loads);
+  fmt::print("Read: {:.0f} bytes, written: {:.0f} bytes\n", report.bytes_read,
+             report.bytes_written);
+  fmt::print("Wall time: {:.6f} s, I/O wait: {:.6f} s\n", report.seconds,
+             report.io_wait_seconds);
+}
+
+}  // namespace cfd
+
+int main(int argc, char** argv) {
+  using Eigen::VectorXd;
+  namespace fs = std::filesystem;
+
+  const auto params = cfd::make_params();
+  const VectorXd x = cfd::make_x(params);
+  cfd::OutOfCoreOptions options;
+  options.chunk_cells = 16;
+  options.steps_per_pass = 4;
+  const auto simulator = cfd::Simulator{params, options};
+  cfd::OutOfCoreReport report;
+
+  // Pulse wave
+  {
+    const auto directory = fs::path("result/tvd_minmod_out_of_core/pulse");
+    const VectorXd u0 = cfd::make_pulse_wave(x);
+    cfd::BinaryFileWriter{directory}.write(u0, "u0.bin");
+    simulator.run(directory / "u0.bin", directory / "u500.bin", &report);
+    const auto uN =
+        cfd::BinaryFileReader{directory}.read("u500.bin", params);
+    const auto writer = cfd::TextFileWriter{directory};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN.values(), "u500.txt");
+    cfd::print_report(report);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include <fmt/core.h>
+
+#include <Eigen/Core>
+
+#include "cfd/cfd.hpp"
+#include "common.hpp"
+
+namespace cfd {
+
+using Simulator = ParallelScalarAdvectionEquationSimulator<
+    RoeRiemannSolver, TvdSpacialReconstructor<MinmodLimiter>,
+    ExplicitEulerScheme>;
+
+void print_report(const ParallelRunReport& report) {
+  fmt::print("Wall time: {:.6f} s\n", report.seconds);
+  for (std::size_t i = 0; i < report.thread_cpus.size(); ++i) {
+    fmt::print("  Thread {} -> CPU {}\n", i, report.thread_cpus[i]);
+  }
+  for (const auto& socket : report.sockets) {
+    fmt::print("  Socket {}: {} threads, {:.3f} GB/s\n", socket.socket,
+               socket.n_threads, socket.gigabytes_per_second());
+  }
+}
+
+}  // namespace cfd
+
+int main(int argc, char** argv) {
+  using Eigen::VectorXd;
+  namespace fs = std::filesystem;
+
+  const auto params = cfd::make_params();
+  const VectorXd x = cfd::make_x(params);
+  const auto simulator = cfd::Simulator{params};
+  cfd::ParallelRunReport report;
+
+  // Sine wave
+  {
+    const VectorXd u0 = cfd::make_sine_wave(x);
+    const VectorXd uN = simulator.run(u0, &report);
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/tvd_minmod_parallel/sine")};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+    cfd::print_report(report);
+  }
+
+  // Pulse wave
+  {
+    const VectorXd u0 = cfd::make_pulse_wave(x);
+    const VectorXd uN = simulator.run(u0, &report);
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/tvd_minmod_parallel/pulse")};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+    cfd::print_report(report);
+  }
+}
\ No newline at end of file
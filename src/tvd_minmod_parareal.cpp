@@ -0,0 +1,95 @@
+#include <fmt/core.h>
+
+#include <Eigen/Core>
+
+#include "cfd/cfd.hpp"
+#include "common.hpp"
+
+namespace cfd {
+
+using FineSimulator =
+    ScalarAdvectionEquationSimulator<RoeRiemannSolver,
+                                     TvdSpacialReconstructor<MinmodLimiter>,
+                                     ExplicitEulerScheme>;
+
+using Simulator = PararealSimulator<FineSimulator>;
+
+void print_report(const PararealReport& report) {
+  fmt::print("Slices: {}, iterations: {}, converged: {}\n", report.n_slices,
+             report.iterations, report.converged);
+  for (std::size_t i = 0; i < report.residuals.size(); ++i) {
+    fmt::print("  Iteration {}: residual {:.3e}\n", i + 1,
+               report.residuals[i]);
+  }
+  fmt::print("Wall time: {:.6f} s, speedup: {:.2f}\n", report.seconds,
+             report.speedup());
+  fmt::print("Speedup with one thread per slice: {:.2f}\n",
+             report.parallel_speedup());
+}
+
+/**
+ * Sine wave on a grid large enough for each slice to amortize its thread,
+ * compared with a serial fine run
+ */
+void run_large_grid(int n_slices) {
+  auto params = make_params();
+  params.n_domain_cells = 4000;
+  params.dx = 2.0 / params.n_domain_cells;
+  params.dt = 0.2 * params.dx;
+  params.n_timesteps = 4000;
+  const Eigen::VectorXd u0 = make_sine_wave(make_x(params));
+
+  const Eigen::VectorXd u_fine = FineSimulator{params}.run(u0);
+  PararealOptions options;
+  options.n_slices = n_slices;
+  PararealReport report;
+  const Eigen::VectorXd uN = Simulator{params, options}.run(u0, &report);
+
+  fmt::print("Large grid ({} cells, {} time steps):\n", params.n_domain_cells,
+             params.n_timesteps);
+  print_report(report);
+  fmt::print("Difference from the serial fine run: {:.3e}\n",
+             (uN - u_fine).lpNorm<Eigen::Infinity>());
+  fmt::print("Difference between fine and coarse propagation: {:.3e}\n",
+             report.coarse_fine_difference);
+}
+
+}  // namespace cfd
+
+int main(int argc, char** argv) {
+  using Eigen::VectorXd;
+  namespace fs = std::filesystem;
+
+  const auto params = cfd::make_params();
+  const VectorXd x = cfd::make_x(params);
+  cfd::PararealOptions options;
+  options.n_slices = 8;
+  const auto simulator = cfd::Simulator{params, options};
+  cfd::PararealReport report;
+
+  // Sine wave
+  {
+    const VectorXd u0 = cfd::make_sine_wave(x);
+    const VectorXd uN = simulator.run(u0, &report);
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/tvd_minmod_parareal/sine")};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+    cfd::print_report(report);
+  }
+
+  // Pulse wave
+  {
+    const VectorXd u0 = cfd::make_pulse_wave(x);
+    const VectorXd uN = simulator.run(u0, &report);
+    const auto writer =
+        cfd::TextFileWriter{fs::path("result/tvd_minmod_parareal/pulse")};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+    cfd::print_report(report);
+  }
+
+  cfd::run_large_grid(options.n_slices);
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include <Eigen/Core>
+#include <array>
+#include <string>
+
+#include "cfd/cfd.hpp"
+#include "common.hpp"
+
+namespace cfd {
+
+using Simulator =
+    MultiLimiterSimulator<RoeRiemannSolver, ExplicitEulerScheme,
+                          PeriodicBoundary, MinmodLimiter, SuperbeeLimiter,
+                          VanLeerLimiter, VanAlbadaLimiter>;
+
+const std::array<std::string, Simulator::n_variants> limiter_names = {
+    "minmod", "superbee", "van_leer", "van_albada"};
+
+template <typename Derived>
+void write_results(const Eigen::VectorXd& x, const Eigen::VectorXd& u0,
+                   const Eigen::MatrixBase<Derived>& uN,
+                   const std::string& wave) {
+  namespace fs = std::filesystem;
+  for (int k = 0; k < Simulator::n_variants; ++k) {
+    const auto writer = TextFileWriter{fs::path("result/tvd_multi_limiter") /
+                                       limiter_names[k] / wave};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN.col(k), "u500.txt");
+  }
+}
+
+}  // namespace cfd
+
+int main(int argc, char** argv) {
+  using Eigen::VectorXd;
+
+  const auto params = cfd::make_params();
+  const VectorXd x = cfd::make_x(params);
+  const auto simulator = cfd::Simulator{params};
+
+  // Sine wave
+  {
+    const VectorXd u0 = cfd::make_sine_wave(x);
+    cfd::write_results(x, u0, simulator.run(u0), "sine");
+  }
+
+  // Pulse wave
+  {
+    const VectorXd u0 = cfd::make_pulse_wave(x);
+    cfd::write_results(x, u0, simulator.run(u0), "pulse");
+  }
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include <Eigen/Core>
+#include <cmath>
+
+#include "cfd/cfd.hpp"
+#include "common.hpp"
+
+namespace cfd {
+
+using Simulator = VariableVelocityAdvectionEquationSimulator<
+    RoeRiemannSolver, TvdSpacialReconstructor<MinmodLimiter>,
+    ExplicitEulerScheme>;
+
+/**
+ * Velocity c(x, t) = 1 + 0.5 sin(pi x) cos(pi t), which is periodic in the
+ * domain [-1, 1] and always positive.
+ */
+VelocityField make_velocity_field(const ProblemParameters& params) {
+  return VelocityField{params, make_x_faces(params),
+                       [](double x, double t) {
+                         return 1.0 + 0.5 * std::sin(M_PI * x) *
+                                          std::cos(M_PI * t);
+                       },
+                       true};
+}
+
+}  // namespace cfd
+
+int main(int argc, char** argv) {
+  using Eigen::VectorXd;
+  namespace fs = std::filesystem;
+
+  const auto params = cfd::make_params();
+  const VectorXd x = cfd::make_x(params);
+  const auto simulator =
+      cfd::Simulator{params, cfd::make_velocity_field(params)};
+
+  // Sine wave
+  {
+    const VectorXd u0 = cfd::make_sine_wave(x);
+    const VectorXd uN = simulator.run(u0);
+    const auto writer = cfd::TextFileWriter{
+        fs::path("result/variable_velocity_tvd_minmod/sine")};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+  }
+
+  // Pulse wave
+  {
+    const VectorXd u0 = cfd::make_pulse_wave(x);
+    const VectorXd uN = simulator.run(u0);
+    const auto writer = cfd::TextFileWriter{
+        fs::path("result/variable_velocity_tvd_minmod/pulse")};
+    writer.write(x, "x.txt");
+    writer.write(u0, "u0.txt");
+    writer.write(uN, "u500.txt");
+  }
+}
\ No newline at end of file